@@ -14,7 +14,7 @@
 *
 *   2. Compile using the library:
 *
-*         gcc -o $HOME/bin/dmp dmp.c -L$HOME/lib -ldatam
+*         gcc -o $HOME/bin/dmp dmp.c -L$HOME/lib -ldatam -lz -pthread
 *
 *   3. Support for the 'what' command is provided via the arcane string that's
 *      assigned to the 'What' variable.  The "@(#)" part is what 'what' detects
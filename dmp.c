@@ -1,5 +1,5 @@
 /*******************************************************************************
-* File: dmp.c						     v0.24   04/04/2025
+* File: dmp.c						     v0.49   10/17/2026
 *
 * Purpose: File hex/ASCII dump utility.
 *
@@ -13,18 +13,43 @@
 *   Multiple filenames may be specified, and options affect the dump output of
 *   all the files that follow.  If dumping from a pipe, all options affect the
 *   pipe dump output.  Input from a pipe overrides and precludes input from a
-*   file (or files).
+*   file (or files).  Other redirected input (dmp < file) is dumped when no
+*   files are named; redirected files and devices are read with seeks.
 *
 * Usage:  dmp  [ [ options ]  [-|--]  [ file.ext ] ] ...
 *
 *    or:  echo "example pipe contents"  |  dmp  [ options ]
 *
+*    or:  dmp  [ options ]  <  file.ext
+*
 * Options:
 *       +# = start dump at byte #  (default: start at first byte in file: '+0')
 *       -# = limit dump to # bytes (default: dump all bytes in file: '-0')
 *       -a = omit (-) or show (+) ASCII dump
+*  -a:utf8 = show the text column as UTF-8 (characters at their lead bytes,
+*            blanks under the rest), -a:ascii as ASCII again
+*   -a:cp = show the text column in code page cp: latin1, ebcdic037, or
+*            ebcdic500 (shown as Latin-1)
+*   -a=f = show the text column through the 256-byte table in file f (the
+*            Latin-1 character for each byte value)
+*      -ar = dump each member of tar, tar.gz, and zip file(s) (+ar: off)
+*  -ar:m,. = dump only the members matching m,... (wildcards allowed)
 *      -b# = set byte group to # bytes, -b = 1 (default), +b = 2
 *       -c = continuous byte dump as fixed-length lines (-) or single string (+)
+* -xor:hex = transform each byte: XOR with the (repeating) hex key, which
+*            lines up with address 0 (up to 64 key bytes)
+*   -add:# = transform each byte: add # (-sub:# to subtract), modulo 256
+*  -bitrev = transform each byte: reverse its bits (-nibswap: swap nibbles)
+*      -xf = clear the byte transforms (which apply in the order given)
+* -stride:K:p = dump word p (default 0) of every K words (of the -b/-w,
+*            or -y, size), addressed by their input offsets (-stride: off)
+*   -chan:N = dump N interleaved channels (words, as -stride) one after the
+*            other, each in its own section (regular files, but not with
+*            +z, +D or -o; -chan: off)
+*   -color = color bytes by class (NUL, printable, white space, control,
+*            high) off (-) or on (+) (default: on for a terminal)
+*       -d = omit (-) or show (+) sector numbers with line/address numbers
+*       -D = don't (-) or do (+) use direct I/O (O_DIRECT) for device reads
 *     -e.# = set output file extension to # (default: "dmp")
 *       -f = output to file: file.dmp (-) or file.ext.dmp (+)
 *     -f.# = output to file: file.#   (-) or file.ext.#   (+)
@@ -33,22 +58,68 @@
 *  -f:#.## = output to file #.##  in current (-) or input file's (+) directory
 *  -f=#.## = output to file #.##  in current (-) or input file's (+) directory
 *            (the -f: and -f= options combine all outputs into the named file)
+*   -done = keep (-) or delete (+) watched files once they are dumped
+* -done=d = move watched files to directory d once they are dumped
 *       -i = omit (-) or show (+) information headers
+*      -j# = run # -watch workers at a time (default: one per CPU)
 *       -l = use lowercase (-) or uppercase (+) ASCII digits (default)
+*      -mt = read, format and write on one thread (-) or on three (+)
+*            (on the NUMA node that caches the input, when there are several)
+*     -mux = dump the following FIFOs/devices together as they arrive, each
+*            line tagged with its stream name (+mux: off)
 *       -n = omit (-) or show (+) line/address numbers
 *      -n# = format line/address as #: s:short (default), l:long, v:variable
-*      -p# = dump # bytes per line (default is 16)
+*       -o = end an output: the format and -f options so far make one
+*            output, the next starts from them (but to stdout); the input
+*            is read once, and each output is rendered on its own thread
+*            (a device is read as a plain stream: +D and +z don't apply)
+*      -p# = dump # bytes per line (default is 16, up to 65536; the ASCII
+*            column is kept at any width)
+* -pid#:r,... = dump memory of process #: all regions, or regions r (mapping
+*            name, like "heap" or "libc", or a lo-hi hex address range);
+*            -# limits the bytes dumped, +# doesn't apply
+*      -r# = dump digits in radix #: 16 (hex, default), 8 (octal), 10
+*            (decimal), or 2 (binary bits), grouped per -b/-w
+*   -y:t## = dump ## bit (8, 16, 32, 64) little- (-) or big-endian (+) words
+*            of type t: u:unsigned, s:signed, x:hex, f:float (32, 64 only)
+*       -y = dump bytes (typed words off)
+*  -s:n,... = dump ELF sections n (like .rodata) or PT_LOAD segments (load,
+*            load#), with file offset (-) or virtual address (+) addresses
+*  -s=lo-hi = dump ELF PT_LOAD file data in the lo-hi (hex) vaddr range
+*            (+# starts within each part, -# limits the whole selection)
+*       -s = dump whole files (ELF selection off)
+*       -t = omit (-) or show (+) arrival time stamps on each dump line
+*   +t:fb = time stamp format f: r:relative (default), a:absolute, d:delta;
+*            with b, stamp only the lines where a read (burst) starts
+*       -u = buffer output for throughput (-) or flush each dump line (+)
+*      +u# = flush output when no input has arrived for # milliseconds
 *      -w# = set word group to # bytes, -w = 4, +w = 8
 *       -x = omit (-) or show (+) hex digits dump
 *       -X = emulate 'hexdump -C -v' output format
+*       -z = dump (-) or skip (+) all-zero sectors (default: skip for devices,
+*            except in the -X/-xxd/-od/-cc emulations and the encoders)
 *      -xo = hex-only dump: as bytes (-) or continuous (+)
+*     -xxd = emulate 'xxd' output format (-xxd:p for 'xxd -p', -xxd:i for
+*            'xxd -i')
+*      -od = emulate 'od -A x -t x1z' output format (repeats shown as '*')
+* -base64 = encode as base64 (-) or decode base64 (+); -p# sets the bytes
+*            per line (default 57: 76 characters), '-p' is no line breaks
+* -base32 = encode as base32 (-) or decode base32 (+) (default 45 per line)
+* -ascii85 = encode as Ascii85 (-) or decode Ascii85 (+) (default 64 per line)
+* -cc:t=n = write C source: array n (default: from the file name) of type t:
+*            u8 (default), u16le, u32le, u64le (or ..be), or str (a string
+*            literal), and n_len (bytes); -p# sets the bytes per line
 *   -about = show about message
 *   -debug = enable debug outputs
 *    -help = show help message
 *     -ver = show version message
+*    -view = browse file(s) interactively (renders only the visible lines)
+* -watch:d = dump each file written or moved into directory d (until ^C),
+*            to files by the -f rules; 'kill -USR1' reports the backlog
 *
 * Notes:
-*   1. Compile instructions:  gcc -o $HOME/bin/dmp dmp.c -L$HOME/lib -ldatam
+*   1. Compile instructions:  gcc -o $HOME/bin/dmp dmp.c -L$HOME/lib -ldatam -lz
+*                                 -pthread
 *        (to only assemble):  gcc -o dmp.s -S dmp.c
 *
 *   2. Support for the 'what' command is provided via the arcane string that's
@@ -96,27 +167,406 @@
 *   0.22  04/03/2025  return code zero for no-args operation
 *   0.23  04/04/2025  switch '--about' and '--version' to '+' options
 *   0.24  04/04/2025  reworked option flags (no functional changes)
+*   0.25  10/17/2026  block-read line formatter; added -view interactive viewer
+*   0.26  10/17/2026  added -pid# process memory dumps (process_vm_readv)
+*   0.27  10/17/2026  added -ar tar/tar.gz/zip member dumps (zlib)
+*   0.28  10/17/2026  added -s ELF section/segment dumps
+*   0.29  10/17/2026  block device support (-d, -D, -z); 64-bit byte counts
+*   0.30  10/17/2026  accept any non-terminal stdin; seek redirected files
+*   0.31  10/17/2026  added -mux multiplexed stream capture (epoll)
+*   0.32  10/17/2026  added +t arrival time stamps (relative/absolute/delta)
+*   0.33  10/17/2026  added -u/+u/+u# output flush policies
+*   0.34  10/17/2026  added -watch:dir spool dumping on a worker pool (-j#)
+*   0.35  10/17/2026  added +mt reader/formatter/writer pipeline (SPSC rings)
+*   0.36  10/17/2026  NUMA placement for +mt and -watch workers; node stats
+*   0.37  10/17/2026  address column kept as an incremental text counter
+*   0.38  10/17/2026  any line width with the ASCII column; line format plan
+*   0.39  10/17/2026  added -o: several outputs from one read (renderer threads)
+*   0.40  10/17/2026  added -xxd(:p, :i), -od; -X: NUL as '.', end offset line
+*   0.41  10/17/2026  added -cc C array/string source output
+*   0.42  10/17/2026  added -base64, -base32 and -ascii85 encoding (+: decoding)
+*   0.43  10/17/2026  added -r# octal, decimal and binary digit dumps
+*   0.44  10/17/2026  added -y typed (integer, float) little/big-endian words
+*   0.45  10/17/2026  added the -a:utf8 text column
+*   0.46  10/17/2026  added -a:latin1, -a:ebcdic037/500 and -a=file code pages
+*   0.47  10/17/2026  added -color byte class coloring (automatic on a terminal)
+*   0.48  10/17/2026  added -xor, -add, -sub, -bitrev and -nibswap transforms
+*   0.49  10/17/2026  added -stride and -chan (deinterleaved) dumps
 *
 *******************************************************************************/
 
-static char  *What = "@(#)dmp.c v0.24 04/04/2025 DataM";
+static char  *What = "@(#)dmp.c v0.49 10/17/2026 DataM";
 static char  *Title = "File Hex/ASCII Dump Utility";
 
+#define _GNU_SOURCE    /* for memmem() and memrchr() */
+
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <dirent.h>
 #include <errno.h>
+#include <float.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <termios.h>
+#include <time.h>
 #include <unistd.h>
 
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include <sys/mman.h>
+#include <sys/poll.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+
+#include <linux/futex.h>
+#include <zlib.h>
 
 #include "datam.h"
 
+/* dump buffer sizes */
+
+#define DumpBuf  65536            /* input block size */
+#define DumpTxt  65536            /* rendered-text staging size */
+
+#define PerMax   65536            /* most bytes per dump line (-p#) */
+
+#define RingSize   8              /* +mt pipeline blocks (per stage) */
+#define RingSpin   2000           /* +mt ring spins before sleeping */
+
+#define OutMax     16             /* most outputs from one read (-o) */
+
+#define XfMax      8              /* most byte transform steps */
+#define XfKey      64             /* longest -xor key (bytes) */
+#define XfBuf      65536          /* bytes transformed at a time */
+
+#define NodeMax    64             /* most NUMA nodes handled */
+#define NodePages  64             /* pages sampled to place an input */
+
+#define DevBuf     1048576        /* device read size */
+#define DevAlign   4096           /* device read alignment */
+
+#define ArchBuf    262144         /* archive read/inflate buffer size */
+
+#define ProcBuf    1048576        /* process memory batch size */
+#define ProcIov    1024           /* process memory pages per batch */
+
+#define MuxMax     256            /* most streams in one -mux capture */
+#define MuxTag     32             /* longest stream tag on dump lines */
+
+#define WatchMax   256            /* most -watch workers */
+#define WatchEvt   65536          /* inotify event buffer size */
+#define WatchPoll  1000           /* -watch idle wake-up (milliseconds) */
+
+#define ViewBlk    64             /* viewer lines per cached page */
+#define ViewPages  8              /* viewer pages kept in the cache */
+#define ViewSeek   1048576        /* viewer search block (w/o mmap) */
+
+/* +mt pipeline: a buffer (input bytes or dump text), and a queue of them */
+
+struct pblk
+{
+   unsigned char  *buf;
+   int            n;       /* bytes in 'buf' (input: 0 = end, < 0 = error) */
+};
+
+struct ring    /* lock-free, single-producer/single-consumer */
+{
+   struct pblk   *slot[RingSize];
+   unsigned int  head;     /* blocks queued (changed by the producer only) */
+   unsigned int  tail;     /* blocks taken  (changed by the consumer only) */
+   unsigned int  wait;     /* a side is asleep on head/tail (futex) */
+};
+
+struct mtpipe
+{
+   struct ring  in, inf;      /* input blocks: full (to format), free */
+   struct ring  out, outf;    /* text blocks: full (to write), free */
+   struct pblk  blk[ RingSize * 2 ];
+
+   int        (*rd)( void*, unsigned char*, int );
+   void       *src;
+   FILE       *fpo;
+   long long  limit;    /* bytes for the reader to read (0: all) */
+   int        stop;     /* the formatter is done: reader, stop reading */
+   int        node;     /* NUMA node that all three stages run on */
+};
+
+/* format plan: the dump line layout, worked out once per option set */
+
+struct fplan
+{
+   int   per;         /* bytes per line (0: continuous) */
+   int   pre;         /* most characters before the hex (tag, stamp, address) */
+   int   hex;         /* characters in a whole line's hex portion */
+   int   line;        /* most characters in any one line (with the '\n') */
+   int   amin;        /* fewest address digits */
+   int   emin;        /*   (and in the final address line, -X or od) */
+   char  asep[4];     /* what follows the address ("  ", or ": " for xxd) */
+   char  abar[2];     /* what brackets the ASCII column ("||", "><", none) */
+   int   sqz;         /* show repeated lines as a "*" line (od) */
+   int   cin;         /* lines are C array items (xxd -i) */
+   int   cw;          /* -cc: bytes per array item (-1: string literal) */
+   int   cbe;         /*   (the words are big-endian) */
+   char  ci[256][6];  /*   (and each byte's "0x2f, " item) */
+   int   rw;          /* -r#: digits per byte (hex 2, octal and decimal */
+   char  rd[256][8];  /*   3, binary 8), and each byte's digits */
+   int   tw, tc;      /* -y: bytes per typed word, and its column width */
+   int   tk, tbe;     /*   (u, s, x, or f; and big-endian) */
+   int   eg;          /* -base64/32, -ascii85: bytes per encoded group */
+   int   dec;         /*   (+: decoding, the text back to bytes) */
+   char  *ea;         /*   (the alphabet) */
+   char  e64[4096][2];    /*   (base64: the two characters for 12 bits) */
+   signed char  dv[256];  /*   (decoding: each character's value, or <0) */
+   char  asc[256];    /* ASCII column character for each byte value */
+   int   u8;          /*   (or -a:utf8: whole UTF-8 characters shown) */
+   int   ax;          /*   (some are Latin-1, written out as UTF-8) */
+   int   col;         /* -color: bytes colored by class (only as it changes) */
+   char  cls[256];    /*   (each byte value's class) */
+   char  esc[5][6];   /*   (each class's escape sequence) */
+   char  ch[256][8];  /*   (and each byte's escape and hex digits) */
+   int   xn;          /* byte transform steps (-xor, -add, ...) */
+   unsigned char  *xk;    /*   (the -xor key, repeated: XfBuf + XfKey) */
+   int   sk, sp, sw;  /* -stride: every sk'th sw-byte word, from word sp */
+};
+
+/* output spec (-o): one output's format settings and destination, and */
+/* its renderer's queues (input blocks in, and back once rendered) */
+
+struct ospec
+{
+   int   ascii, locase, wordlen, perline, addrnum, halfgap, endaddr;
+   int   ascwide, hexdump, sectors, stamp, stampfmt, stampburst, emul;
+   int   ccword, ccbig, enc, radix, wtype, wbits, wbig, textcode, color;
+   unsigned char  *textmap;
+   char           xfop[XfMax];
+   unsigned char  xfarg[XfMax], xfkey[XfKey];
+   int            xfn, xfkl;
+   int            stride, strideph;
+   char  *ccname;
+   int   header, footer, tofile, locdir, addext, allout, newout;
+   char  outfile[1024], outextn[256], outname[1024];
+   FILE  *fpo;
+
+   struct ring  in, back;
+   pthread_t    tid;
+   long long    adr;    /* address of the renderer's first byte */
+};
+
+/* dump stream state: next address, partial line, and rendered text */
+
+struct dmps
+{
+   long long      adr;    /* address of the next byte in the stream */
+   long long      cnt;    /* number of bytes dumped from the stream */
+   int            ix;     /* number of bytes in the current dump line */
+   int            txn;    /* number of characters staged in 'txt' */
+   unsigned char  *byt;   /* the current dump line's bytes (Plan.per) */
+   char           *txt;   /* rendered dump lines waiting to be written */
+   long long      gap;    /* bytes skipped (not yet reported) */
+   char           *why;   /*   (and why they were skipped) */
+   long long      tln;    /* time stamp of the current dump line (ns) */
+   long long      tprv;   /* previous time stamp shown (delta format) */
+   long long      tbeg;   /* time the dump started (relative format) */
+   int            tmark;  /* the current dump line shows its stamp */
+   unsigned char  *xb;    /* transformed bytes (-xor, -add, ...) */
+   unsigned char  *sb;    /* -stride: the words picked out of a block */
+   long long      sbase;  /*   (the stream's first address) */
+   int            spos;   /*   (the next byte's place in the K words) */
+   int            sset;   /*   (the first address is known) */
+   unsigned char  *lst;   /* the last whole line's bytes (od squeezing) */
+   int            lsn;    /*   (there is a last line) */
+   int            rep;    /*   (and its "*" repeat line is out) */
+   int            gn;     /* encoding: bytes held (or decoding: characters) */
+   unsigned long long  gv;    /*   (decoding: the group's value so far) */
+   long long           bad;   /*   (characters that aren't in the alphabet) */
+   struct mtpipe  *mp;    /* +mt: text goes to the writer thread ... */
+   struct pblk    *tb;    /*   (in this block, which 'txt' points into) */
+};
+
+/* byte source: a span of a file */
+
+struct span
+{
+   int        fd;
+   long long  pos;     /* file offset of the next byte */
+   long long  left;    /* bytes left in the span */
+};
+
+/* multiplexed input stream (-mux) */
+
+struct muxs
+{
+   int          fd;
+   int          tln;                /* length of 'tag' */
+   char         tag[MuxTag + 4];    /* line prefix: padded stream name */
+   long long    skip;               /* bytes left to skip (to Start) */
+   struct dmps  ds;
+};
+
+/* -watch: a file waiting to be dumped, and a worker dumping one */
+
+struct wjob
+{
+   struct wjob  *next;
+   char         name[];
+};
+
+struct wslot
+{
+   int          pid;    /* worker process (0: slot is free) */
+   int          node;   /*   (running on this NUMA node) */
+   long long    size;   /*   (dumping this many bytes) */
+   long long    t0;     /*   (since this time) */
+   struct wjob  *job;
+};
+
+/* viewer page cache entry: a page of rendered lines */
+
+struct vpage
+{
+   long long  page;                 /* page number (line / ViewBlk) */
+   int        off[ViewBlk + 1];     /* offset of each line in 'txt' */
+   char       *txt;                 /* the rendered lines (no newlines) */
+};
+
 /* helper functions */
 
-int  dump_file( FILE* fpi, FILE* fpo );
+long long  dump_file( FILE* fpi, FILE* fpo );
+long long  dump_src( FILE* fpo, int (*rd)( void*, unsigned char*, int ),
+                     void* src, long long skip, long long adr );
+int  read_fd( void* src, unsigned char* buf, int size );
+int  read_span( void* src, unsigned char* buf, int size );
+
+void  dump_header();
+void  dump_footer( long long cnt );
+
+int   dump_open( struct dmps* ds, long long adr );
+int   dump_same( struct dmps* ds, unsigned char* p );
+void  dump_dec( FILE* fpo, struct dmps* ds, unsigned char* buf, long long n );
+void  dec_group( struct dmps* ds );
+void  dump_close( struct dmps* ds );
+void  dump_bytes( FILE* fpo, struct dmps* ds, unsigned char* buf, long long n );
+void  xf_apply( unsigned char* out, unsigned char* in, long long n,
+                long long adr );
+int   stride_pick( struct dmps* ds, unsigned char* out, unsigned char* in,
+                   int n );
+void  dump_end( FILE* fpo, struct dmps* ds );
+void  dump_gap( FILE* fpo, struct dmps* ds, long long n, char* why );
+void  dump_flush( FILE* fpo );
+void  dump_emit( FILE* fpo, struct dmps* ds );
+
+long long  dump_mt( FILE* fpo, int (*rd)( void*, unsigned char*, int ),
+                    void* src, long long skip, long long adr );
+void*      mt_reader( void* arg );
+void*      mt_writer( void* arg );
+
+int        dump_outs();
+long long  dump_fan( int (*rd)( void*, unsigned char*, int ), void* src,
+                     long long skip, long long adr );
+void*      fan_render( void* arg );
+void       out_save( struct ospec* sp );
+void       out_load( struct ospec* sp );
+void       out_fmt( struct ospec* sp );
+
+void          ring_put( struct ring* r, struct pblk* b );
+struct pblk*  ring_get( struct ring* r );
+int           ring_empty( struct ring* r );
+void          ring_wait( struct ring* r, unsigned int* word, unsigned int seen );
+void  dump_note( FILE* fpo, struct dmps* ds );
+
+long long  dump_dev( FILE* fpo, int fd, long long size, int ssz, int zeros );
+void       dev_put( FILE* fpo, struct dmps* ds, unsigned char* p, long long at,
+                    long long n, long long end, int ssz, int zeros );
+int        is_zero( unsigned char* p, long long n );
+
+void  plan_make();
+char* c_name( char* name );
+
+int  fmt_addr( char* out, long long adr );
+int  fmt_hex( char* out, unsigned char* byt, long long n, int ix );
+int  col_off( char* out );
+int  fmt_word( char* out, unsigned char* byt, int n );
+int  fmt_flt( char* out, double v, int f32 );
+int  fmt_utf8( char* out, unsigned char* byt, int n );
+int  fmt_line( char* out, unsigned char* byt, int n, long long adr );
+int  fmt_cc( char* out, unsigned char* byt, int n );
+int  fmt_enc( char* out, unsigned char* byt, int n );
+int  fmt_stamp( char* out, struct dmps* ds, int show );
+int  fmt_dec( char* out, unsigned long long v, int width, char pad );
+
+long long  stamp_clock();
+void       stamp_wall();
+
+int   dump_archive( char* name );
+int   arch_member( char* path, int (*rd)( void*, unsigned char*, int ),
+                   void* src );
+int   arch_want( char* path );
+int   arch_tar( int fd );
+int   arch_zip( int fd );
+int   tar_read( void* src, unsigned char* buf, int size );
+int   zip_deflated( void* src, unsigned char* buf, int size );
+
+long long  tar_num( unsigned char* fld, int len );
+
+unsigned int        le16( unsigned char* p );
+unsigned int        le32( unsigned char* p );
+unsigned long long  le64( unsigned char* p );
+
+long long  dump_elf( FILE* fpi, FILE* fpo );
+long long  elf_span( FILE* fpo, int fd, long long off, long long size,
+                     long long adr, long long done );
+int   elf_want( char* name );
+
+long long  elf_num( unsigned char* p, int len );
+
+long long  dump_proc( FILE* fpi, FILE* fpo );
+int   dump_mux();
+int   dump_watch( char* dir );
+int   watch_dump( char* path );
+void  watch_add( char* dir, char* name, char* ext );
+void  watch_done( int pid, int st );
+void  watch_stats();
+void  watch_sig( int sig );
+int   watch_node( char* path, long long* size );
+void  node_stat( int node, long long bytes, long long ns );
+
+int   numa_nodes();
+int   numa_here();
+int   numa_where( void* adr, long long size );
+int   numa_file( int fd, long long pos );
+void  numa_bind( int node );
+
+long long  mux_put( FILE* fpo, struct muxs* m, unsigned char* buf, long long n );
+void       mux_end( FILE* fpo, struct muxs* m );
+void       mux_stop( int sig );
+int   proc_sel( char* map, long long* lo, long long* hi );
+
+int    view_file( char* name );
+void   view_done();
+void   view_winch( int sig );
+void   view_size();
+void   view_put( char* str, int len );
+char*  view_line( long long line, int* len );
+void   view_draw( char* name, long long top, long long hit, char* msg );
+int    view_ask( char* prompt, char* ln, int size );
+int    view_pat( char* ln, unsigned char* pat, int size );
+
+long long  view_find( long long from, unsigned char* pat, int len, int dir );
+
+unsigned char*  find_last( unsigned char* hay, long long n,
+                           unsigned char* pat, int len );
 
 int  proc_args( int* aix, int argc, char** argv );
+int  arg_inputs( int argc, char** argv );
 int  open_files();
 
 int  help_msg( int mx );
@@ -125,17 +575,125 @@ int  about_msg( int mx );
 
 /* global variables */
 
-static int   Debug, ToFile, Ascii, LoCase, WordLen, PerLine, AddrNum;
-static int   Count, Header, Footer, LocDir, AddExt, HalfGap, EndAddr;
-static int   AscWide, TermFmt, HexDump, Start, Pipe, AllOut, NewOut, Files;
+static int   Debug, ToFile, Header, Footer, LocDir, AddExt;
+static int   TermFmt, Pipe, PipeSeek, AllOut, NewOut, Files, Outs;
+static int   SecSize, Zeros, Direct;
+static int   Mux, MuxN, LineTagN, Flush, FlushMs;
+static int   Nodes, WatchRr;
+static int   Mt, Jobs, WatchDel, WatchRun, WatchQueue, WatchPeak;
+static int   View, Proc, Arch, ArchHits, Elf, ElfVad, ElfW, ElfB;
 
 static char  *Pgm, *Name, *DefExts;
 static char  DefExtn[256], OutName[1024], OutExtn[256], OutFile[1024];
 
-static char  *DefExtd = ".dmp", *DefPipe = "pipe";
+static char  *DefExtd = ".dmp", *DefPipe = "pipe", *DefMux = "mux";
+
+static char  *MuxName[MuxMax], *LineTag, *WatchDir, *WatchTo;
+
+static volatile sig_atomic_t  MuxStop, WatchStop, WatchStat;
+
+static char  *ProcSel, ProcName[32], *ArchSel, *ArchName, *ElfSel;
+
+static long long  Count, Start, ElfLo, ElfHi, StampWall, WatchDone, WatchFail;
+static long long  DecBad;
+
+static unsigned long long  ElfHits;    /* -s: the selections matched (bits) */
+static unsigned long long  ArchSelHits;    /* -ar: the same, for members */
+static unsigned long long  ProcSelHits;    /* -pid: and for mappings */
+
+static struct wjob   *WatchHead, *WatchTail;
+static struct wslot  *Work;
+
+static cpu_set_t  NodeCpus[NodeMax];
+static long long  NodeFiles[NodeMax], NodeBytes[NodeMax], NodeNs[NodeMax];
+
+static char  *HexUp = "0123456789ABCDEF", *HexLo = "0123456789abcdef";
+
+static unsigned char  Ebc037[256] =    /* EBCDIC 037 to Latin-1 */
+{
+   0x00, 0x01, 0x02, 0x03, 0x9c, 0x09, 0x86, 0x7f, 0x97, 0x8d, 0x8e, 0x0b,
+   0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x9d, 0x85, 0x08, 0x87,
+   0x18, 0x19, 0x92, 0x8f, 0x1c, 0x1d, 0x1e, 0x1f, 0x80, 0x81, 0x82, 0x83,
+   0x84, 0x0a, 0x17, 0x1b, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x05, 0x06, 0x07,
+   0x90, 0x91, 0x16, 0x93, 0x94, 0x95, 0x96, 0x04, 0x98, 0x99, 0x9a, 0x9b,
+   0x14, 0x15, 0x9e, 0x1a, 0x20, 0xa0, 0xe2, 0xe4, 0xe0, 0xe1, 0xe3, 0xe5,
+   0xe7, 0xf1, 0xa2, 0x2e, 0x3c, 0x28, 0x2b, 0x7c, 0x26, 0xe9, 0xea, 0xeb,
+   0xe8, 0xed, 0xee, 0xef, 0xec, 0xdf, 0x21, 0x24, 0x2a, 0x29, 0x3b, 0xac,
+   0x2d, 0x2f, 0xc2, 0xc4, 0xc0, 0xc1, 0xc3, 0xc5, 0xc7, 0xd1, 0xa6, 0x2c,
+   0x25, 0x5f, 0x3e, 0x3f, 0xf8, 0xc9, 0xca, 0xcb, 0xc8, 0xcd, 0xce, 0xcf,
+   0xcc, 0x60, 0x3a, 0x23, 0x40, 0x27, 0x3d, 0x22, 0xd8, 0x61, 0x62, 0x63,
+   0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0xab, 0xbb, 0xf0, 0xfd, 0xfe, 0xb1,
+   0xb0, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0xaa, 0xba,
+   0xe6, 0xb8, 0xc6, 0xa4, 0xb5, 0x7e, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78,
+   0x79, 0x7a, 0xa1, 0xbf, 0xd0, 0xdd, 0xde, 0xae, 0x5e, 0xa3, 0xa5, 0xb7,
+   0xa9, 0xa7, 0xb6, 0xbc, 0xbd, 0xbe, 0x5b, 0x5d, 0xaf, 0xa8, 0xb4, 0xd7,
+   0x7b, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0xad, 0xf4,
+   0xf6, 0xf2, 0xf3, 0xf5, 0x7d, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50,
+   0x51, 0x52, 0xb9, 0xfb, 0xfc, 0xf9, 0xfa, 0xff, 0x5c, 0xf7, 0x53, 0x54,
+   0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0xb2, 0xd4, 0xd6, 0xd2, 0xd3, 0xd5,
+   0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0xb3, 0xdb,
+   0xdc, 0xd9, 0xda, 0x9f
+};
+
+static unsigned char  Ebc500[256] =    /* EBCDIC 500 to Latin-1 */
+{
+   0x00, 0x01, 0x02, 0x03, 0x9c, 0x09, 0x86, 0x7f, 0x97, 0x8d, 0x8e, 0x0b,
+   0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x9d, 0x85, 0x08, 0x87,
+   0x18, 0x19, 0x92, 0x8f, 0x1c, 0x1d, 0x1e, 0x1f, 0x80, 0x81, 0x82, 0x83,
+   0x84, 0x0a, 0x17, 0x1b, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x05, 0x06, 0x07,
+   0x90, 0x91, 0x16, 0x93, 0x94, 0x95, 0x96, 0x04, 0x98, 0x99, 0x9a, 0x9b,
+   0x14, 0x15, 0x9e, 0x1a, 0x20, 0xa0, 0xe2, 0xe4, 0xe0, 0xe1, 0xe3, 0xe5,
+   0xe7, 0xf1, 0x5b, 0x2e, 0x3c, 0x28, 0x2b, 0x21, 0x26, 0xe9, 0xea, 0xeb,
+   0xe8, 0xed, 0xee, 0xef, 0xec, 0xdf, 0x5d, 0x24, 0x2a, 0x29, 0x3b, 0x5e,
+   0x2d, 0x2f, 0xc2, 0xc4, 0xc0, 0xc1, 0xc3, 0xc5, 0xc7, 0xd1, 0xa6, 0x2c,
+   0x25, 0x5f, 0x3e, 0x3f, 0xf8, 0xc9, 0xca, 0xcb, 0xc8, 0xcd, 0xce, 0xcf,
+   0xcc, 0x60, 0x3a, 0x23, 0x40, 0x27, 0x3d, 0x22, 0xd8, 0x61, 0x62, 0x63,
+   0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0xab, 0xbb, 0xf0, 0xfd, 0xfe, 0xb1,
+   0xb0, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0xaa, 0xba,
+   0xe6, 0xb8, 0xc6, 0xa4, 0xb5, 0x7e, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78,
+   0x79, 0x7a, 0xa1, 0xbf, 0xd0, 0xdd, 0xde, 0xae, 0xa2, 0xa3, 0xa5, 0xb7,
+   0xa9, 0xa7, 0xb6, 0xbc, 0xbd, 0xbe, 0xac, 0x7c, 0xaf, 0xa8, 0xb4, 0xd7,
+   0x7b, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0xad, 0xf4,
+   0xf6, 0xf2, 0xf3, 0xf5, 0x7d, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50,
+   0x51, 0x52, 0xb9, 0xfb, 0xfc, 0xf9, 0xfa, 0xff, 0x5c, 0xf7, 0x53, 0x54,
+   0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0xb2, 0xd4, 0xd6, 0xd2, 0xd3, 0xd5,
+   0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0xb3, 0xdb,
+   0xdc, 0xd9, 0xda, 0x9f
+};
 
 static FILE  *Fpi, *Fpo;
 
+static struct ospec  OutSpec[OutMax];
+
+/* line format settings: per thread, so each -o renderer has its own */
+
+static __thread int  Ascii, LoCase, WordLen, PerLine, AddrNum, HalfGap, EndAddr;
+static __thread int  AscWide, HexDump, Sectors, Stamp, StampFmt, StampBurst;
+static __thread int  Emul, CcWord, CcBig, Enc, Radix, WType, WBits, WBig;
+static __thread int  TextCode, Color;
+static __thread unsigned char  *TextMap;
+
+static __thread char           XfOp[XfMax];     /* byte transform steps, */
+static __thread unsigned char  XfArg[XfMax];    /*   (and their arguments) */
+static __thread unsigned char  XfKeyB[XfKey];   /*   (and the -xor key) */
+static __thread int            XfN, XfKl;
+
+static __thread int        Stride, StridePh;    /* -stride:K:p (and -chan) */
+static __thread long long  StrideBase;          /*   (the stream's start) */
+static int                 Chans;               /* -chan:N */
+static __thread char *CcName;
+
+static __thread struct fplan  Plan;
+static __thread FILE          *FlushOut;
+
+/* interactive viewer state */
+
+static int             ViewFd = -1, ViewTty = -1, ViewRows, ViewCols;
+static long long       ViewSize;
+static unsigned char   *ViewMap, *ViewBuf;
+static struct termios  ViewTio;
+static struct vpage    ViewCache[ViewPages];
+
 
 /* the main program for dmp */
 
@@ -143,7 +701,8 @@ int  main( int argc, char** argv )
 {
    struct stat  sts;    /* used to detect pipe operations */
 
-   int  aix, cnt, count, err;
+   long long  cnt;
+   int        aix, err;
 
    /* set-up global defaults */
 
@@ -156,8 +715,11 @@ int  main( int argc, char** argv )
    LocDir  = 1;    /* output to local (current) directory */
    LoCase  = 0;    /* dump hex in uppercase (0) or lowercase (1) */
    Ascii   = 1;    /* dump ASCII representation at end of each line */
+   Color   = -1;   /*   (colored by byte class: off, on, or on a terminal) */
    AscWide = 1;    /* always full width ASCII field */
+   Emul    = 0;    /* dmp's own format (or X hexdump, x/p/i xxd, o od) */
    HexDump = 1;    /* output hex-digits dump */
+   Radix = 16;     /*   (in hex, or octal, decimal, or binary digits) */
    WordLen = 1;    /* group into 1, 2, 4, 8, 16 bytes, or none (0) */
    PerLine = 16;   /* output N bytes per line, or continuous (0) */
    AddrNum = 2;    /* output line address numbers (n1 n2 n3) or don't (0) */
@@ -169,6 +731,28 @@ int  main( int argc, char** argv )
    Count   = 0;    /* number of bytes to dump, or dump all (0) */
    Start   = 0;    /* start dump at first byte in file (0) */
    Pipe    = 0;    /* default input is from files, not from pipe */
+   PipeSeek = 0;   /*   (stdin is a redirected file or device: seekable) */
+   View    = 0;    /* dump files, don't browse them interactively */
+   Proc    = 0;    /* not dumping a process's memory */
+   Arch    = 0;    /* input files are not archives */
+   Elf     = 0;    /* dump whole files, not ELF sections/segments */
+   Sectors = 0;    /* don't show sector numbers with the addresses */
+   SecSize = 512;  /*   (sector size of the current input) */
+   Zeros   = -1;   /* skip all-zero sectors: devices (-1), never, always */
+   Direct  = 0;    /* don't use O_DIRECT for device reads */
+   Mux     = 0;    /* dump each input by itself, not multiplexed */
+   MuxN    = 0;    /*   (number of streams collected for -mux) */
+   Stamp   = 0;    /* don't show time stamps on dump lines */
+   StampFmt = 'r'; /*   (relative, absolute, or delta time stamps) */
+   StampBurst = 0; /*   (stamp every line, or just where a read starts) */
+   Flush   = 0;    /* flush output when buffers fill (0), each line, or idle */
+   FlushMs = 0;    /*   (idle time before flushing, in milliseconds) */
+   Mt      = 0;    /* read, format and write on one thread (no pipeline) */
+   Outs    = 0;    /* one output per input (no -o output specs) */
+   Jobs    = 0;    /* worker processes for -watch (0: one per CPU) */
+   WatchDir = NULL;  /* not watching a directory */
+   WatchTo  = NULL;  /*   (finished inputs are kept, or moved here) */
+   WatchDel = 0;     /*   (or deleted) */
 
    /* set the program name and initialize the 'what' string info */
 
@@ -193,10 +777,20 @@ int  main( int argc, char** argv )
    Fpo = NULL;
 
    /* check for pipe vs. non-pipe first */
+   /* (other non-terminal input is used when no files are named: sockets */
+   /* stream like pipes, while redirected files and devices can seek) */
 
    if ( fstat( STDIN_FILENO, &sts ) != -1 )
+   {
       Pipe = ( ( sts.st_mode & S_IFIFO ) != 0 );
 
+      if ( !Pipe  &&  !isatty( STDIN_FILENO )  &&  !arg_inputs( argc, argv ) )
+      {
+         Pipe = 1;
+         PipeSeek = ( S_ISREG( sts.st_mode )  ||  S_ISBLK( sts.st_mode ) );
+      }
+   }
+
    /* check for no-arguments cases: pipe vs. non-pipe */
    /* (pipe w/o args is okay; non-pipe w/no args shows a clue) */
 
@@ -219,77 +813,117 @@ int  main( int argc, char** argv )
    {
       err = proc_args( &aix, argc, argv );
 
-      if ( Name  &&  !err )   /* open the file */
+      if ( Name  &&  !err  &&  Outs  &&
+           ( Mux || WatchDir || View || Arch || Proc || Elf ) )
       {
-         err = open_files();
-
-         if ( !err  &&  TermFmt )  printf( "\n" );
+         printf( "  -o outputs can't be combined with -mux, -watch, -view,"
+                 " -ar, -pid or -s\n" );
+         err = 1;
       }
 
-      if ( Name  &&  !err )   /* dump the file */
+      if ( Name  &&  !err  &&  Mux  &&  !Pipe  &&  !Proc )   /* a stream */
       {
-         if ( Header )
+         if ( MuxN < MuxMax )
          {
-            if ( AllOut > 1 )  fprintf( Fpo, "\n" );   /* before appended hdr */
-
-            if ( Pipe )
-               fprintf( Fpo, "    Dump of Pipe: (stdin)\n" );
-            else
-               fprintf( Fpo, "    Dump of File: %s\n", Name );
+            MuxName[MuxN++] = Name;
+         }
+         else
+         {
+            printf( "  too many -mux streams (%i at most): \"%s\"\n",
+                    MuxMax, Name );
+            err = 1;
          }
 
-         cnt = dump_file( Fpi, Fpo );
+         Name = NULL;
 
-         /* end-of-file reporting */
+         continue;
+      }
 
-         count = ( cnt >= 0 ? cnt : -cnt );
+      if ( Name  &&  !err  &&  MuxN )   /* dump the streams collected so far */
+      {
+         err = dump_mux();
+      }
 
-         if ( Footer )
-         {
-            if ( cnt >= 0 )
-            {
-               fprintf( Fpo, "    End-of-File   (%i byte%s)",
-                             count, ss( count ) );
+      if ( Name  &&  !err  &&  WatchDir )   /* dump files as they arrive */
+      {
+         err = dump_watch( WatchDir );
 
-               if ( Count )
-                  fprintf( Fpo, "  (EoF before %i-byte limit)\n", Count );
-               else
-                  fprintf( Fpo, "\n" );
-            }
-            else   /* dump ended at byte-count */
-            {
-               fprintf( Fpo, "    End-of-Dump   (%i byte%s)\n",
-                             count, ss( count ) );
-            }
-         }
+         Name = WatchDir = NULL;
 
-         /* report output filename (to stdout) */
+         continue;
+      }
 
-         if ( ToFile )
+      if ( Name  &&  !err  &&  View )   /* browse the file interactively */
+      {
+         if ( Pipe  &&  !PipeSeek )
+         {
+            printf( "  interactive view is not valid in pipe operations\n" );
+            err = 1;
+         }
+         else
          {
-            printf( "    Dumped output (%i byte%s) to file: %s%s\n",
-                    count, ss( count ), OutName,
-                    ( AllOut < 2 ? "" : " (appended)" ) );
+            err = view_file( Pipe ? "/dev/stdin" : Name );
          }
 
-         /* close files and clear names */
+         Name = NULL;
+         Files++;
 
-         if ( Fpo  &&  Fpo != stdout  &&  !AllOut )    /* close output file */
-         {
-            if ( Debug )  printf( "(closing output file)\n" );
+         continue;
+      }
 
-            memset( OutName, 0x00, sizeof(OutName) );
+      if ( Name  &&  !err  &&  Arch  &&  ( !Pipe || PipeSeek )  &&  !Proc )
+      {
+         err = dump_archive( Pipe ? "/dev/stdin" : Name );    /* archive */
 
-            fclose( Fpo );
-            Fpo = NULL;
+         Name = NULL;
+
+         continue;
+      }
+
+      if ( Name  &&  !err  &&  Outs )   /* one read, several outputs */
+      {
+         err = dump_outs();
+
+         if ( !Pipe )    /* close input file (not a pipe) */
+         {
+            if ( Fpi )  fclose( Fpi );
+            Fpi = NULL;
+
+            Name = NULL;
          }
 
+         Files++;
+
+         continue;
+      }
+
+      if ( Name  &&  !err )   /* open the file */
+      {
+         err = open_files();
+
+         if ( !err  &&  TermFmt )  printf( "\n" );
+      }
+
+      if ( Name  &&  !err )   /* dump the file */
+      {
+         dump_header();
+
+         if ( Proc )
+            cnt = dump_proc( Fpi, Fpo );
+         else if ( Elf  &&  ( !Pipe || PipeSeek ) )
+            cnt = dump_elf( Fpi, Fpo );
+         else
+            cnt = dump_file( Fpi, Fpo );
+
+         dump_footer( cnt );
+
          if ( !Pipe )    /* close input file (not a pipe) */
          {
             if ( Fpi )  fclose( Fpi );
             Fpi = NULL;
 
             Name = NULL;
+            Proc = 0;
          }
 
          Files++;    /* another input file was processed */
@@ -301,6 +935,8 @@ int  main( int argc, char** argv )
 
    } while ( aix < argc  &&  !err );
 
+   if ( MuxN  &&  !err )  err = dump_mux();    /* the final -mux streams */
+
    /* end-of-loop terminal operations */
 
    /* close output file (when combining all outputs into one file) */
@@ -315,12 +951,165 @@ int  main( int argc, char** argv )
       Fpo = NULL;
    }
 
+   for ( aix = 0;  aix < Outs;  aix++ )    /* (and the -o combined outputs) */
+   {
+      if ( OutSpec[aix].fpo  &&  OutSpec[aix].fpo != stdout )
+         fclose( OutSpec[aix].fpo );
+   }
+
    if ( Files  &&  TermFmt )  printf( "\n" );
 
    return ( err );
 }
 
 
+/* dump_header - write the information header for the current input */
+
+void  dump_header()
+{
+   if ( Emul == 'i'  &&  !Pipe )    /* xxd -i: the C array's declaration */
+      fprintf( Fpo, "unsigned char %s[] = {\n", c_name( Name ) );
+
+   if ( Emul == 'c' )    /* -cc: the C array (or string) declaration */
+   {
+      char  *id = ( CcName ? CcName : c_name( Name ) );
+
+      if ( CcWord < 0 )
+         fprintf( Fpo, "static const char %s[] =", id );
+      else if ( CcWord == 1 )
+         fprintf( Fpo, "static const unsigned char %s[] = {\n", id );
+      else
+         fprintf( Fpo, "#include <stdint.h>\n\n"
+                       "static const uint%i_t %s[] = {\n", CcWord * 8, id );
+   }
+
+   if ( Header )
+   {
+      if ( AllOut > 1 )  fprintf( Fpo, "\n" );   /* before appended hdr */
+
+      if ( ArchName )
+         fprintf( Fpo, "    Dump of File: %s   (in %s)\n", Name, ArchName );
+      else if ( MuxN )
+         fprintf( Fpo, "    Dump of Streams: %i\n", MuxN );
+      else if ( Pipe )
+         fprintf( Fpo, "    Dump of %s: (stdin)\n",
+                  ( PipeSeek ? "File" : "Pipe" ) );
+      else if ( Proc )
+         fprintf( Fpo, "    Dump of Process: %i\n", Proc );
+      else
+         fprintf( Fpo, "    Dump of File: %s\n", Name );
+   }
+
+   return;
+}
+
+
+/* c_name - an input name as a C identifier, the way xxd -i makes it */
+
+char*  c_name( char* name )
+{
+   static char  id[1024];
+
+   int  i, n = 0;
+
+   if ( isdigit( (unsigned char) name[0] ) )    /* "__" before a digit */
+   {
+      id[n++] = '_';
+      id[n++] = '_';
+   }
+
+   for ( i = 0;  name[i]  &&  n < (int) sizeof(id) - 1;  i++ )
+      id[n++] = ( isalnum( (unsigned char) name[i] ) ? name[i] : '_' );
+
+   id[n] = '\0';
+
+   return ( id );
+}
+
+
+/* dump_footer - end-of-file reporting, and close the output file */
+
+void  dump_footer( long long cnt )
+{
+   long long  count;
+
+   /* end-of-file reporting */
+
+   count = ( cnt >= 0 ? cnt : -cnt );
+
+   if ( Emul == 'd'  &&  DecBad )    /* +base64 ...: report bad input */
+   {
+      fprintf( stderr, "  %lli character%s not in the %s alphabet skipped\n",
+               DecBad, ss( DecBad == 1 ), ( Enc == 64 ? "base64" :
+                                            Enc == 32 ? "base32" : "ascii85" ) );
+      DecBad = 0;
+   }
+
+   if ( Emul == 'c' )    /* -cc: end the array (or string), and the length */
+   {
+      fprintf( Fpo, ( CcWord < 0 ? ( count ? ";\n" : " \"\";\n" ) : "};\n" ) );
+
+      fprintf( Fpo, "static const unsigned long %s_len = %lli;\n",
+               ( CcName ? CcName : c_name( Name ) ), count );
+   }
+
+   if ( Emul == 'i' )    /* xxd -i: end the last line, and the C array */
+   {
+      if ( count )  fprintf( Fpo, "\n" );
+
+      if ( !Pipe )
+         fprintf( Fpo, "};\nunsigned int %s_len = %lli;\n", c_name( Name ),
+                  count );
+   }
+
+   if ( Footer )
+   {
+      if ( cnt >= 0 )
+      {
+         fprintf( Fpo, "    End-of-File   (%lli byte%s)",
+                       count, ss( count == 1 ) );
+
+         if ( Count )
+            fprintf( Fpo, "  (EoF before %lli-byte limit)\n", Count );
+         else
+            fprintf( Fpo, "\n" );
+      }
+      else   /* dump ended at byte-count */
+      {
+         fprintf( Fpo, "    End-of-Dump   (%lli byte%s)\n",
+                       count, ss( count == 1 ) );
+      }
+   }
+
+   /* report output filename (to stdout) */
+
+   if ( ToFile )
+   {
+      printf( "    Dumped output (%lli byte%s) to file: %s%s\n",
+              count, ss( count == 1 ), OutName,
+              ( AllOut < 2 ? "" : " (appended)" ) );
+   }
+
+   if ( Flush  &&  Fpo )  fflush( Fpo );    /* (no idle wait after the end) */
+
+   FlushOut = NULL;
+
+   /* close files and clear names */
+
+   if ( Fpo  &&  Fpo != stdout  &&  !AllOut )    /* close output file */
+   {
+      if ( Debug )  printf( "(closing output file)\n" );
+
+      memset( OutName, 0x00, sizeof(OutName) );
+
+      fclose( Fpo );
+      Fpo = NULL;
+   }
+
+   return;
+}
+
+
 int  open_files()
 {
    int   err = 0;
@@ -330,7 +1119,15 @@ int  open_files()
 
    /* open the input source */
 
-   if ( Pipe )    /* using pipe for input */
+   if ( ArchName )    /* archive member: read through the archive */
+   {
+      if ( Debug )  printf( "(member of archive: \"%s\")\n", ArchName );
+   }
+   else if ( MuxN )    /* multiplexed streams: opened by dump_mux */
+   {
+      if ( Debug )  printf( "(multiplexing %i streams)\n", MuxN );
+   }
+   else if ( Pipe )    /* using pipe for input */
    {
       if ( Fpi  &&  Fpi != stdin )  fclose( Fpi );    /* just in case */
 
@@ -338,6 +1135,21 @@ int  open_files()
 
       if ( Debug )  printf( "(using pipe for input)\n" );
    }
+   else if ( Proc )    /* process memory: the input is its mappings list */
+   {
+      char  maps[64];
+
+      sprintf( maps, "/proc/%i/maps", Proc );
+
+      if ( ( Fpi = fopen( maps, "r" ) ) == 0 )
+      {
+         err = errno;
+
+         if ( Files )  printf( "\n" );
+         printf( "  error %i opening process maps: \"%s\"\n", err, maps );
+         printf( "  (%s)\n", strerror( err ) );
+      }
+   }
    else if ( ( Fpi = fopen( Name, "r" ) ) == 0 )    /* file open failed */
    {
       err = errno;
@@ -367,7 +1179,11 @@ int  open_files()
             {
                if ( !LocDir )   /* use input directory (if any) */
                {
-                  strncpy( OutName, Name, sizeof(OutName) - 1 );
+                  /* (an archive member's directory is the archive's: */
+                  /* never a path taken from inside the archive) */
+
+                  strncpy( OutName, ( ArchName ? ArchName : Name ),
+                           sizeof(OutName) - 1 );
 
                   if ( ( dot = strrchr( OutName, '/' ) ) )
                   {
@@ -482,7 +1298,7 @@ int  open_files()
    if ( Debug  &&  !err )
    {
       if ( Pipe )
-         printf( "(input from stdin)\n" );
+         printf( "(input from stdin%s)\n", ( PipeSeek ? ", seekable" : "" ) );
       else
          printf( "(opened input file: \"%s\")\n", Name );
 
@@ -496,147 +1312,4932 @@ int  open_files()
 }
 
 
-int  dump_file( FILE* fpi, FILE* fpo )
+long long  dump_file( FILE* fpi, FILE* fpo )
 {
-   int  adr = 0, ch, cnt = 0, ix = 0;
+   struct stat  sts;
 
-   char  asc[64], sp[4];
+   long long  skip = Start, size = 0;
+   int        fd, dev = 0, reg = 0, ssz = 512;
 
    if ( !fpi  ||  !fpo )  return ( 0 );
 
-   memset( asc, 0x00, sizeof(asc) );
+   fd = fileno( fpi );
+
+   /* block devices: get the size and sector size from the device */
 
-   while ( ( ch = fgetc( fpi ) ) != EOF  &&  ( !Count  ||  cnt < Count ) )
+   if ( fstat( fd, &sts ) == 0 )
    {
-      if ( Start  &&  adr < Start )
+      if ( S_ISBLK( sts.st_mode ) )
       {
-         adr++;
-         continue;
-      }
+         unsigned long long  bytes = 0;
 
-      if ( !ix  &&  AddrNum )
+         dev = ( ioctl( fd, BLKGETSIZE64, &bytes ) == 0 );
+         size = bytes;
+
+         if ( ioctl( fd, BLKSSZGET, &ssz ) != 0  ||  ssz <= 0  ||
+              DevAlign % ssz )  ssz = 512;
+      }
+      else if ( S_ISREG( sts.st_mode ) )
       {
-         if ( AddrNum == 1 )
-         {
-            fprintf( fpo, ( LoCase ? "%04x  " : "%04X  " ), adr );
-         }
-         else if ( AddrNum == 2 )
-         {
-            fprintf( fpo, ( LoCase ? "%08x  " : "%08X  " ), adr );
-         }
-         else if ( AddrNum == 3 )
-         {
-            if ( adr < 0x00010000 )
-               fprintf( fpo, ( LoCase ? "    %04x  " : "    %04X  " ), adr );
-            else if ( adr < 0x00100000 )
-               fprintf( fpo, ( LoCase ? "   %05x  " : "   %05X  " ), adr );
-            else if ( adr < 0x01000000 )
-               fprintf( fpo, ( LoCase ? "  %06x  " : "  %06X  " ), adr );
-            else if ( adr < 0x10000000 )
-               fprintf( fpo, ( LoCase ? " %07x  " : " %07X  " ), adr );
-            else /* ( adr < 0x10000000 ) */
-               fprintf( fpo, ( LoCase ? "%08x  " : "%08X  " ), adr );
-         }
+         size = sts.st_size;
+         reg = 1;
       }
+   }
+
+   SecSize = ssz;
 
-      if ( HexDump )  fprintf( fpo, ( LoCase ? "%02x" : "%02X" ), ch );
+   if ( Debug )  printf( "(size: %lli  sector: %i  device: %i)\n",
+                         size, ssz, dev );
 
-      if ( Ascii )
+   /* devices (and files, for +z or +D) take the aligned, sized path */
+
+   if ( dev  ||  ( reg  &&  ( Zeros > 0  ||  Direct ) ) )
+   {
+      if ( Chans )    /* (the sector reads don't deinterleave) */
       {
-         if ( ch == '\0' )
-            asc[ix] = '_';
-         else if ( ch < ' ' )
-            asc[ix] = '.';
-         else if ( ch > '~' )
-            asc[ix] = '.';
-         else
-            asc[ix] = ch;
+         printf( "  -chan doesn't apply to devices, +z or +D\n" );
+         return ( 0 );
       }
 
-      ix++;
-
-      if ( HexDump )
+      if ( Direct  &&  fcntl( fd, F_SETFL, fcntl( fd, F_GETFL ) | O_DIRECT ) )
       {
-         if ( WordLen  &&  ( ix % WordLen ) == 0 )  fprintf( fpo, " " );
-         if ( HalfGap  &&  ( ix % HalfGap ) == 0 )  fprintf( fpo, " " );
+         if ( Debug )  printf( "(O_DIRECT not available: %s)\n",
+                               strerror( errno ) );
       }
 
-      if ( PerLine  &&  ix >= PerLine )
+      /* (zero sectors are skipped by default only in dmp's own format: */
+      /* the emulations and encoders promise every byte) */
+
+      return ( dump_dev( fpo, fd, size, ssz, ( Zeros < 0 ? dev  &&  !Emul
+                                                        : Zeros ) ) );
+   }
+
+   /* seek straight to the start byte when we can; otherwise read past it */
+
+   if ( Chans )    /* -chan:N: a section for each channel, in turn */
+   {
+      long long  cnt = 0, n, r;
+      int        c, sk = Stride, sp = StridePh, lim = 0;
+
+      for ( c = 0;  c < Chans;  c++ )
       {
-         if ( Ascii )
+         if ( lseek( fd, Start, SEEK_SET ) != Start )
          {
-            memset( sp, 0x00, sizeof(sp) );
+            printf( "  -chan needs an input that can be read again\n" );
+            break;
+         }
 
-            if ( HexDump )
-            {
-               strcpy( sp,"  " );
-               if ( WordLen              )  sp[1] = '\0';
-               if ( WordLen  &&  HalfGap )  sp[0] = '\0';
-            }
+         Stride = Chans;
+         StridePh = c;
+         plan_make();
+
+         fprintf( fpo, "%s    (channel %i of %i)\n", ( c  &&  TermFmt ? "\n"
+                       : "" ), c, Chans );
+
+         n = dump_src( fpo, read_fd, &fd, 0, Start );   /* (all read) */
+
+         lim = ( n < 0 );    /* (-: at the -# limit) */
+         if ( lim )  n = -n;
+
+         /* count the channel's own bytes: the total is what was dumped */
+
+         r = n % ( Chans * Plan.sw ) - c * Plan.sw;
+         cnt += n / ( Chans * Plan.sw ) * Plan.sw +
+                ( r < 0 ? 0 : r < Plan.sw ? r : Plan.sw );
+      }
+
+      Stride = sk;    /* (the next file's -stride, as given) */
+      StridePh = sp;
+      plan_make();
+
+      return ( lim ? -cnt : cnt );
+   }
+
+   if ( Start > 0  &&  lseek( fd, Start, SEEK_SET ) == Start )  skip = 0;
+
+   return ( dump_src( fpo, read_fd, &fd, skip, Start - skip ) );
+}
+
+
+/* dump_src - dump a byte source ('skip' bytes in, starting at address adr) */
+
+long long  dump_src( FILE* fpo, int (*rd)( void*, unsigned char*, int ),
+                     void* src, long long skip, long long adr )
+{
+   static unsigned char  buf[DumpBuf];
+
+   struct dmps  ds;
+
+   int  eof = 0, k, n;
+
+   if ( Mt )  return ( dump_mt( fpo, rd, src, skip, adr ) );    /* +mt */
+
+   if ( dump_open( &ds, adr ) )  return ( 0 );
+
+   /* read the input in large blocks and hand them to the line formatter */
+
+   while ( ( n = rd( src, buf, sizeof(buf) ) ) > 0 )
+   {
+      k = 0;
+
+      if ( skip )    /* still reading up to the start byte */
+      {
+         k = ( skip < n ? skip : n );
+         skip -= k;
+         ds.adr += k;
+      }
+
+      if ( Count  &&  n - k > Count - ds.cnt )    /* limit is in this block */
+      {
+         dump_bytes( fpo, &ds, &buf[k], Count - ds.cnt );
+         break;    /* (and there's at least one more byte in the input) */
+      }
+
+      dump_bytes( fpo, &ds, &buf[k], n - k );
+
+      if ( Count  &&  ds.cnt >= Count )    /* limit is at the end of block */
+      {
+         eof = ( rd( src, buf, 1 ) <= 0 );    /* any more input? */
+         break;
+      }
+   }
+
+   if ( n <= 0 )  eof = 1;
+
+   /* end-of-file processing */
+
+   dump_end( fpo, &ds );
+
+   /* report the ending (next) address, like 'hexdump -C -v' */
+
+   if ( EndAddr )  fprintf( fpo, "%0*llx\n", Plan.emin, ds.adr );
+
+   dump_close( &ds );
+
+   /* report differently for End-of-File and count-limited dumps */
+
+   return ( eof ? ds.cnt : -ds.cnt );
+}
+
+
+/* dump_mt - dump_src as a reader/formatter/writer pipeline (+mt) */
+
+long long  dump_mt( FILE* fpo, int (*rd)( void*, unsigned char*, int ),
+                    void* src, long long skip, long long adr )
+{
+   static struct mtpipe  mp;
+   static unsigned char  *mem = NULL;
+   static int            txsz = 0;
+
+   pthread_t    rt, wt;
+   struct dmps  ds;
+   struct pblk  *b;
+
+   static int            memnode = -1;
+
+   cpu_set_t  cpus;
+   long long  cnt, t0;
+   char       *txt;
+   int        eof = 0, done = 0, i, k, n, node;
+
+   /* run where the input's cached pages are (or here), on one NUMA node */
+
+   node = ( rd == read_fd ? numa_file( *(int*) src, lseek( *(int*) src, 0,
+                                       SEEK_CUR ) ) : -1 );
+   if ( node < 0 )  node = numa_here();
+
+   /* the buffers are allocated once, and recycled through the free rings */
+   /* (fresh pages, first touched by the pinned stages: local memory) */
+
+   if ( !mem  ||  txsz < DumpTxt + Plan.line  ||  node != memnode )
+   {
+      if ( mem )  munmap( mem, RingSize * ( DumpBuf + txsz ) );
+
+      txsz = DumpTxt + Plan.line;
+      memnode = node;
+
+      mem = mmap( NULL, RingSize * ( DumpBuf + txsz ), PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+      if ( mem == MAP_FAILED )
+      {
+         mem = NULL;
+         txsz = 0;
+
+         printf( "  error %i allocating pipeline buffers\n", ENOMEM );
+         printf( "  (%s)\n", strerror( ENOMEM ) );
+
+         return ( 0 );
+      }
+   }
+
+   sched_getaffinity( 0, sizeof(cpus), &cpus );
+   numa_bind( node );
+
+   t0 = stamp_clock();
+
+   if ( dump_open( &ds, adr ) )  return ( 0 );
+
+   memset( &mp, 0x00, sizeof(mp) );
+
+   for ( i = 0;  i < RingSize;  i++ )
+   {
+      mp.blk[i].buf = &mem[ i * DumpBuf ];
+      mp.blk[ RingSize + i ].buf = &mem[ RingSize * DumpBuf + i * txsz ];
+
+      ring_put( &mp.inf, &mp.blk[i] );
+      ring_put( &mp.outf, &mp.blk[ RingSize + i ] );
+   }
+
+   mp.rd = rd;
+   mp.src = src;
+   mp.fpo = fpo;
+   mp.limit = ( Count ? skip + Count + 1 : 0 );    /* (+1: the EOF probe) */
+   mp.node = node;
+
+   if ( pthread_create( &rt, NULL, mt_reader, &mp ) )    /* no threads: */
+   {
+      dump_close( &ds );
+
+      if ( Nodes > 1 )  sched_setaffinity( 0, sizeof(cpus), &cpus );
+
+      Mt = 0;
+      cnt = dump_src( fpo, rd, src, skip, adr );    /* (run unpipelined) */
+      Mt = 1;
+
+      return ( cnt );
+   }
+
+   /* format on this thread; text blocks go to the writer as they fill */
+
+   txt = ds.txt;
+
+   if ( !pthread_create( &wt, NULL, mt_writer, &mp ) )
+   {
+      ds.mp = &mp;
+      ds.tb = ring_get( &mp.outf );
+      ds.txt = (char*) ds.tb->buf;
+   }
+
+   while ( ( n = ( b = ring_get( &mp.in ) )->n ) > 0 )
+   {
+      k = 0;
+
+      if ( skip )    /* still reading up to the start byte */
+      {
+         k = ( skip < n ? skip : n );
+         skip -= k;
+         ds.adr += k;
+      }
+
+      if ( Count  &&  n - k > Count - ds.cnt )    /* limit is in this block */
+      {
+         dump_bytes( fpo, &ds, &b->buf[k], Count - ds.cnt );
+         ring_put( &mp.inf, b );
+         break;    /* (and there's at least one more byte in the input) */
+      }
+
+      dump_bytes( fpo, &ds, &b->buf[k], n - k );
+      ring_put( &mp.inf, b );
+
+      if ( Count  &&  ds.cnt >= Count )    /* limit is at the end of block */
+      {
+         b = ring_get( &mp.in );
+         eof = done = ( b->n <= 0 );    /* any more input? */
+         ring_put( &mp.inf, b );
+         break;
+      }
+   }
+
+   if ( n <= 0 )    /* (the reader's end marker) */
+   {
+      ring_put( &mp.inf, b );
+      eof = done = 1;
+   }
+
+   /* stop the reader (if it's not done) and take back its blocks */
+
+   __atomic_store_n( &mp.stop, 1, __ATOMIC_SEQ_CST );
+
+   while ( !done )
+   {
+      b = ring_get( &mp.in );
+      done = ( b->n <= 0 );
+      ring_put( &mp.inf, b );
+   }
+
+   pthread_join( rt, NULL );
+
+   /* end-of-file processing (the last line), then let the writer finish */
+
+   dump_end( fpo, &ds );
+
+   if ( ds.mp )
+   {
+      ds.tb->n = -1;
+      ring_put( &mp.out, ds.tb );
+
+      pthread_join( wt, NULL );
+
+      ds.mp = NULL;
+   }
+
+   ds.txt = txt;
+
+   if ( Nodes > 1 )  sched_setaffinity( 0, sizeof(cpus), &cpus );
+
+   node_stat( node, ds.cnt, stamp_clock() - t0 );
+
+   if ( Debug )  printf( "(+mt node %i: %lli bytes, %lli MB/s)\n", node,
+                         NodeBytes[node], NodeBytes[node] * 1000 /
+                         ( NodeNs[node] ? NodeNs[node] : 1 ) );
+
+   if ( EndAddr )  fprintf( fpo, "%0*llx\n", Plan.emin, ds.adr );
+
+   dump_close( &ds );
+
+   return ( eof ? ds.cnt : -ds.cnt );
+}
+
+
+/* mt_reader - pipeline reader: fill free input blocks from the source */
+
+void*  mt_reader( void* arg )
+{
+   struct mtpipe  *mp = arg;
+   struct pblk    *b;
+
+   long long  left = mp->limit;
+   int        want;
+
+   numa_bind( mp->node );
+
+   do
+   {
+      b = ring_get( &mp->inf );
+
+      want = ( mp->limit  &&  left < DumpBuf ? left : DumpBuf );
+
+      if ( want > 0  &&  !__atomic_load_n( &mp->stop, __ATOMIC_SEQ_CST ) )
+         b->n = mp->rd( mp->src, b->buf, want );
+      else
+         b->n = 0;    /* (stopped, or at the count limit) */
+
+      if ( b->n > 0 )  left -= b->n;
+
+      ring_put( &mp->in, b );
+
+   } while ( b->n > 0 );
+
+   return ( NULL );
+}
+
+
+/* mt_writer - pipeline writer: write text blocks, then hand them back */
+
+void*  mt_writer( void* arg )
+{
+   struct mtpipe  *mp = arg;
+   struct pblk    *b;
+
+   numa_bind( mp->node );
+
+   while ( ( b = ring_get( &mp->out ) )->n >= 0 )
+   {
+      fwrite( b->buf, 1, b->n, mp->fpo );
+
+      /* (with -u policies: flush whenever the writer catches up) */
+
+      if ( Flush  &&  ring_empty( &mp->out ) )  fflush( mp->fpo );
+
+      ring_put( &mp->outf, b );
+   }
+
+   ring_put( &mp->outf, b );
+
+   return ( NULL );
+}
+
+
+/* dump_outs - dump the input once to every -o output (and the current one) */
+
+int  dump_outs()
+{
+   struct ospec  *sp;
+
+   long long  cnt, skip = Start;
+   int        err = 0, fd, i, tty = 0;
+
+   if ( Chans )    /* (each channel re-reads the input: not one pass) */
+   {
+      printf( "  -chan doesn't apply with -o outputs\n" );
+      return ( 1 );
+   }
+
+   out_save( &OutSpec[Outs] );    /* the current options: the last output */
+
+   for ( i = 0;  i <= Outs  &&  !err;  i++ )    /* open each destination */
+   {
+      sp = &OutSpec[i];
+      out_load( sp );
+
+      if ( i  &&  !Pipe  &&  Fpi )    /* (the input is read just once) */
+      {
+         fclose( Fpi );
+         Fpi = NULL;
+      }
+
+      err = open_files();
+      tty += ( !err  &&  Fpo == stdout );
+
+      out_save( sp );
+   }
+
+   if ( !err  &&  tty > 1 )
+   {
+      printf( "  only one -o output can go to stdout (use -f for others)\n" );
+      err = 1;
+   }
+
+   if ( !err )
+   {
+      if ( TermFmt )  printf( "\n" );
+
+      for ( i = 0;  i <= Outs;  i++ )
+      {
+         out_load( &OutSpec[i] );
+         dump_header();
+      }
+
+      /* seek straight to the start byte when we can (like dump_file) */
+      /* (every input is read as a stream: devices skip the sector path) */
+
+      fd = fileno( Fpi );
+
+      if ( Start > 0  &&  lseek( fd, Start, SEEK_SET ) == Start )  skip = 0;
+
+      cnt = dump_fan( read_fd, &fd, skip, Start - skip );
+
+      for ( i = 0;  i <= Outs;  i++ )
+      {
+         sp = &OutSpec[i];
+         out_load( sp );
+
+         dump_footer( cnt );
+
+         out_save( sp );
+      }
+   }
+
+   out_load( &OutSpec[Outs] );    /* back to the current options */
+
+   return ( err );
+}
+
+
+/* dump_fan - read the input once, and have a renderer thread for each */
+/* output format the same (shared, read-only) blocks */
+
+long long  dump_fan( int (*rd)( void*, unsigned char*, int ), void* src,
+                     long long skip, long long adr )
+{
+   static unsigned char  *mem = NULL;
+
+   struct pblk    blk[RingSize], end, *b = NULL;
+   struct ospec   *sp;
+   unsigned char  probe;
+
+   long long  cnt = 0, want;
+   int        eof = 0, over = 0, i, k, n, run, used = 0;
+
+   if ( !mem  &&  !( mem = malloc( RingSize * DumpBuf ) ) )
+   {
+      printf( "  error %i allocating output buffers\n", ENOMEM );
+      printf( "  (%s)\n", strerror( ENOMEM ) );
+
+      return ( 0 );
+   }
+
+   stamp_wall();    /* (set once here: the renderers share it) */
+
+   end.buf = NULL;
+   end.n = 0;
+
+   for ( run = 0;  run <= Outs;  run++ )    /* start the renderers */
+   {
+      sp = &OutSpec[run];
+
+      memset( &sp->in, 0x00, sizeof(sp->in) );
+      memset( &sp->back, 0x00, sizeof(sp->back) );
+
+      sp->adr = adr + skip;
+
+      if ( pthread_create( &sp->tid, NULL, fan_render, sp ) )
+      {
+         printf( "  error %i starting output renderers\n", EAGAIN );
+         printf( "  (%s)\n", strerror( EAGAIN ) );
+
+         break;
+      }
+   }
+
+   /* read into each block in turn, once every renderer is done with it */
+
+   while ( run > Outs )
+   {
+      if ( !b  &&  used < RingSize )    /* (b: all of the last read skipped) */
+      {
+         b = &blk[used];
+         b->buf = &mem[ used++ * DumpBuf ];
+      }
+      else if ( !b )    /* the oldest block, back from every renderer */
+      {
+         for ( i = 0;  i <= Outs;  i++ )  b = ring_get( &OutSpec[i].back );
+      }
+
+      want = DumpBuf;
+      if ( Count  &&  !skip  &&  Count - cnt < want )  want = Count - cnt;
+
+      if ( !want )    /* at the count limit: is there any more input? */
+      {
+         eof = ( !over  &&  rd( src, &probe, 1 ) <= 0 );
+         break;
+      }
+
+      if ( ( n = rd( src, b->buf, want ) ) <= 0 )
+      {
+         eof = 1;
+         break;
+      }
+
+      if ( skip )    /* still reading up to the start byte */
+      {
+         k = ( skip < n ? skip : n );
+         skip -= k;
+         n -= k;
+
+         if ( n )  memmove( b->buf, &b->buf[k], n );
+
+         if ( Count  &&  n > Count - cnt )    /* (more input past the limit) */
+         {
+            n = Count - cnt;
+            over = 1;
+         }
+
+         if ( !n )  continue;
+      }
+
+      b->n = n;
+      cnt += n;
+
+      for ( i = 0;  i <= Outs;  i++ )  ring_put( &OutSpec[i].in, b );
+
+      b = NULL;
+   }
+
+   /* end each renderer's input, and wait for it to finish */
+
+   for ( i = 0;  i < run;  i++ )  ring_put( &OutSpec[i].in, &end );
+
+   for ( i = 0;  i < run;  i++ )
+   {
+      while ( ring_get( &OutSpec[i].back ) != &end )  ;
+
+      pthread_join( OutSpec[i].tid, NULL );
+   }
+
+   return ( eof ? cnt : -cnt );
+}
+
+
+/* fan_render - an output's renderer: dump each block with its own format */
+
+void*  fan_render( void* arg )
+{
+   struct ospec  *sp = arg;
+   struct dmps   ds;
+   struct pblk   *b;
+
+   int  ok;
+
+   out_fmt( sp );    /* (this thread's copy of the format settings) */
+
+   ok = !dump_open( &ds, sp->adr );
+
+   while ( ( b = ring_get( &sp->in ) )->n > 0 )
+   {
+      if ( ok )  dump_bytes( sp->fpo, &ds, b->buf, b->n );
+
+      /* (with +u#: flush whenever the renderer catches up) */
+
+      if ( FlushOut  &&  ring_empty( &sp->in ) )
+      {
+         fflush( FlushOut );
+         FlushOut = NULL;
+      }
+
+      ring_put( &sp->back, b );
+   }
+
+   if ( ok )
+   {
+      dump_end( sp->fpo, &ds );
+
+      if ( EndAddr )  fprintf( sp->fpo, "%0*llx\n", Plan.emin, ds.adr );
+
+      dump_close( &ds );
+   }
+
+   ring_put( &sp->back, b );    /* (the end marker) */
+
+   return ( NULL );
+}
+
+
+/* out_save - record the current format options and destination in sp */
+
+void  out_save( struct ospec* sp )
+{
+   sp->ascii      = Ascii;
+   sp->locase     = LoCase;
+   sp->wordlen    = WordLen;
+   sp->perline    = PerLine;
+   sp->addrnum    = AddrNum;
+   sp->halfgap    = HalfGap;
+   sp->endaddr    = EndAddr;
+   sp->ascwide    = AscWide;
+   sp->hexdump    = HexDump;
+   sp->sectors    = Sectors;
+   sp->stamp      = Stamp;
+   sp->stampfmt   = StampFmt;
+   sp->stampburst = StampBurst;
+   sp->emul       = Emul;
+   sp->ccword     = CcWord;
+   sp->ccbig      = CcBig;
+   sp->ccname     = CcName;
+   sp->enc        = Enc;
+   sp->radix      = Radix;
+   sp->wtype      = WType;
+   sp->wbits      = WBits;
+   sp->wbig       = WBig;
+   sp->textcode   = TextCode;
+   sp->textmap    = TextMap;
+   sp->xfn        = XfN;
+   sp->xfkl       = XfKl;
+   sp->stride     = Stride;
+   sp->strideph   = StridePh;
+
+   memcpy( sp->xfop, XfOp, sizeof(XfOp) );
+   memcpy( sp->xfarg, XfArg, sizeof(XfArg) );
+   memcpy( sp->xfkey, XfKeyB, sizeof(XfKeyB) );
+   sp->color      = ( Color < 0 ? !ToFile  &&  isatty( STDOUT_FILENO )
+                                : Color );    /* (auto: terminal only) */
+
+   sp->header = Header;
+   sp->footer = Footer;
+   sp->tofile = ToFile;
+   sp->locdir = LocDir;
+   sp->addext = AddExt;
+   sp->allout = AllOut;
+   sp->newout = NewOut;
+   sp->fpo    = Fpo;
+
+   memcpy( sp->outfile, OutFile, sizeof(OutFile) );
+   memcpy( sp->outextn, OutExtn, sizeof(OutExtn) );
+   memcpy( sp->outname, OutName, sizeof(OutName) );
+
+   return;
+}
+
+
+/* out_load - make sp's options and destination the current ones */
+
+void  out_load( struct ospec* sp )
+{
+   out_fmt( sp );
+
+   Header = sp->header;
+   Footer = sp->footer;
+   ToFile = sp->tofile;
+   LocDir = sp->locdir;
+   AddExt = sp->addext;
+   AllOut = sp->allout;
+   NewOut = sp->newout;
+   Fpo    = sp->fpo;
+
+   memcpy( OutFile, sp->outfile, sizeof(OutFile) );
+   memcpy( OutExtn, sp->outextn, sizeof(OutExtn) );
+   memcpy( OutName, sp->outname, sizeof(OutName) );
+
+   return;
+}
+
+
+/* out_fmt - take sp's line format settings (for this thread) */
+
+void  out_fmt( struct ospec* sp )
+{
+   Ascii      = sp->ascii;
+   LoCase     = sp->locase;
+   WordLen    = sp->wordlen;
+   PerLine    = sp->perline;
+   AddrNum    = sp->addrnum;
+   HalfGap    = sp->halfgap;
+   EndAddr    = sp->endaddr;
+   AscWide    = sp->ascwide;
+   HexDump    = sp->hexdump;
+   Sectors    = sp->sectors;
+   Stamp      = sp->stamp;
+   StampFmt   = sp->stampfmt;
+   StampBurst = sp->stampburst;
+   Emul       = sp->emul;
+   CcWord     = sp->ccword;
+   CcBig      = sp->ccbig;
+   CcName     = sp->ccname;
+   Enc        = sp->enc;
+   Radix      = sp->radix;
+   WType      = sp->wtype;
+   WBits      = sp->wbits;
+   WBig       = sp->wbig;
+   TextCode   = sp->textcode;
+   TextMap    = sp->textmap;
+   Color      = sp->color;
+   XfN        = sp->xfn;
+   XfKl       = sp->xfkl;
+   Stride     = sp->stride;
+   StridePh   = sp->strideph;
+
+   memcpy( XfOp, sp->xfop, sizeof(XfOp) );
+   memcpy( XfArg, sp->xfarg, sizeof(XfArg) );
+   memcpy( XfKeyB, sp->xfkey, sizeof(XfKeyB) );
+
+   FlushOut = NULL;
+
+   plan_make();
+
+   return;
+}
+
+
+/* ring_put - queue a block (waits while the ring is full) */
+
+void  ring_put( struct ring* r, struct pblk* b )
+{
+   unsigned int  h = r->head;    /* (only the producer changes head) */
+
+   while ( h - __atomic_load_n( &r->tail, __ATOMIC_SEQ_CST ) >= RingSize )
+      ring_wait( r, &r->tail, h - RingSize );
+
+   r->slot[ h % RingSize ] = b;
+
+   __atomic_store_n( &r->head, h + 1, __ATOMIC_SEQ_CST );
+
+   if ( __atomic_load_n( &r->wait, __ATOMIC_SEQ_CST ) )
+      syscall( SYS_futex, &r->head, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+
+   return;
+}
+
+
+/* ring_get - take the next block (waits while the ring is empty) */
+
+struct pblk*  ring_get( struct ring* r )
+{
+   unsigned int  t = r->tail;    /* (only the consumer changes tail) */
+   struct pblk   *b;
+
+   while ( __atomic_load_n( &r->head, __ATOMIC_SEQ_CST ) == t )
+      ring_wait( r, &r->head, t );
+
+   b = r->slot[ t % RingSize ];
+
+   __atomic_store_n( &r->tail, t + 1, __ATOMIC_SEQ_CST );
+
+   if ( __atomic_load_n( &r->wait, __ATOMIC_SEQ_CST ) )
+      syscall( SYS_futex, &r->tail, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+
+   return ( b );
+}
+
+
+int  ring_empty( struct ring* r )
+{
+   return ( __atomic_load_n( &r->head, __ATOMIC_SEQ_CST ) == r->tail );
+}
+
+
+/* ring_wait - wait for the other side to move *word off 'seen' */
+
+void  ring_wait( struct ring* r, unsigned int* word, unsigned int seen )
+{
+   int  i;
+
+   for ( i = 0;  i < RingSpin;  i++ )    /* a short spin first */
+   {
+      if ( __atomic_load_n( word, __ATOMIC_SEQ_CST ) != seen )  return;
+   }
+
+   __atomic_add_fetch( &r->wait, 1, __ATOMIC_SEQ_CST );
+
+   syscall( SYS_futex, word, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0 );
+
+   __atomic_sub_fetch( &r->wait, 1, __ATOMIC_SEQ_CST );
+
+   return;
+}
+
+
+/* dump_dev - dump a sized input (block device) with large aligned reads */
+
+long long  dump_dev( FILE* fpo, int fd, long long size, int ssz, int zeros )
+{
+   static unsigned char  *buf = NULL;
+
+   struct dmps  ds;
+
+   long long  at, cnt, end, got, n, pos;
+
+   if ( !buf  &&  posix_memalign( (void**) &buf, DevAlign, DevBuf ) )
+   {
+      buf = NULL;
+
+      printf( "  error %i allocating device buffers\n", ENOMEM );
+      printf( "  (%s)\n", strerror( ENOMEM ) );
+
+      return ( 0 );
+   }
+
+   if ( dump_open( &ds, Start ) )  return ( 0 );
+
+   end = ( Count  &&  Start + Count < size ? Start + Count : size );
+
+   for ( pos = Start - Start % DevAlign;  pos < end;  pos += n )
+   {
+      n = ( end - pos < DevBuf ? end - pos : DevBuf );
+      n = ( n + DevAlign - 1 ) / DevAlign * DevAlign;    /* whole blocks */
+
+      if ( ( got = pread( fd, buf, n, pos ) ) > 0 )
+      {
+         dev_put( fpo, &ds, buf, pos, got, end, ssz, zeros );
+
+         n = got;
+         continue;
+      }
+
+      if ( !got )  break;    /* (the device ended early) */
+
+      /* a bad spot in this block: go sector-by-sector around it */
+
+      for ( at = pos;  at < pos + n  &&  at < end;  at += ssz )
+      {
+         if ( pread( fd, buf, ssz, at ) == ssz )
+            dev_put( fpo, &ds, buf, at, ssz, end, ssz, zeros );
+         else
+            dev_put( fpo, &ds, NULL, at, ssz, end, ssz, 0 );
+      }
+   }
+
+   dump_end( fpo, &ds );
+
+   if ( EndAddr )  fprintf( fpo, "%0*llx\n", Plan.emin, ds.adr );
+
+   cnt = ds.cnt;
+
+   dump_close( &ds );
+
+   return ( end < size ? -cnt : cnt );
+}
+
+
+/* dev_put - dump device data read at 'at' (NULL data: unreadable) */
+
+void  dev_put( FILE* fpo, struct dmps* ds, unsigned char* p, long long at,
+               long long n, long long end, int ssz, int zeros )
+{
+   long long  k, dn = 0;
+
+   /* trim to the dump range (the reads are block-aligned) */
+
+   if ( at < Start )
+   {
+      if ( ( k = Start - at ) >= n )  return;
+
+      if ( p )  p += k;
+      at += k;
+      n -= k;
+   }
+
+   if ( at + n > end )  n = end - at;
+
+   if ( n <= 0 )  return;
+
+   if ( !p )
+   {
+      dump_gap( fpo, ds, n, "unreadable" );
+      return;
+   }
+
+   if ( !zeros )
+   {
+      dump_bytes( fpo, ds, p, n );
+      return;
+   }
+
+   /* skip whole all-zero sectors; dump everything else */
+
+   for ( ;  n > 0;  p += k, at += k, n -= k )
+   {
+      k = ssz - at % ssz;
+      if ( k > n )  k = n;
+
+      if ( k == ssz  &&  is_zero( p, k ) )
+      {
+         if ( dn )  dump_bytes( fpo, ds, p - dn, dn );
+         dn = 0;
+
+         dump_gap( fpo, ds, k, "zero" );
+      }
+      else
+      {
+         dn += k;
+      }
+   }
+
+   if ( dn )  dump_bytes( fpo, ds, p - dn, dn );
+
+   return;
+}
+
+
+/* is_zero - check for all-zero bytes (a word at a time) */
+
+int  is_zero( unsigned char* p, long long n )
+{
+   unsigned long long  w[8], acc;
+
+   for ( ;  n >= (long long) sizeof(w);  p += sizeof(w), n -= sizeof(w) )
+   {
+      memcpy( w, p, sizeof(w) );    /* (compiles to plain loads) */
+
+      acc = w[0] | w[1] | w[2] | w[3] | w[4] | w[5] | w[6] | w[7];
+
+      if ( acc )  return ( 0 );
+   }
+
+   for ( ;  n > 0;  p++, n-- )
+   {
+      if ( *p )  return ( 0 );
+   }
+
+   return ( 1 );
+}
+
+
+/* read_fd - byte source: a file descriptor */
+
+int  read_fd( void* src, unsigned char* buf, int size )
+{
+   struct pollfd  pf;
+
+   int  n;
+
+   if ( FlushOut )    /* (+u#) flush if no input comes within the idle time */
+   {
+      pf.fd = *(int*) src;
+      pf.events = POLLIN;
+
+      if ( poll( &pf, 1, FlushMs ) == 0 )
+      {
+         fflush( FlushOut );
+         FlushOut = NULL;
+      }
+   }
+
+   do  n = read( *(int*) src, buf, size );  while ( n < 0  &&  errno == EINTR );
+
+   return ( n );
+}
+
+
+/* read_span - byte source: a span of a file (positioned reads) */
+
+int  read_span( void* src, unsigned char* buf, int size )
+{
+   struct span  *sp = src;
+   int          n;
+
+   if ( size > sp->left )  size = sp->left;
+   if ( size <= 0 )  return ( 0 );
+
+   if ( ( n = pread( sp->fd, buf, size, sp->pos ) ) > 0 )
+   {
+      sp->pos += n;
+      sp->left -= n;
+   }
+
+   return ( n );
+}
+
+
+int  dump_open( struct dmps* ds, long long adr )
+{
+   memset( ds, 0x00, sizeof(*ds) );
+
+   ds->adr = adr;
+
+   if ( Stamp )    /* relative and delta stamps start from here */
+   {
+      ds->tbeg = ds->tprv = stamp_clock();
+
+      stamp_wall();    /* (and absolute stamps need the wall clock) */
+   }
+
+   ds->byt = malloc( Plan.per > 8 ? Plan.per : 8 );    /* (or a group) */
+   ds->txt = malloc( DumpTxt + Plan.line );
+
+   if ( Plan.sqz )  ds->lst = malloc( Plan.per );
+   if ( Plan.xn )  ds->xb = malloc( XfBuf );
+   if ( Plan.sk )  ds->sb = malloc( XfBuf );
+
+   if ( !ds->byt  ||  !ds->txt  ||  ( Plan.sqz  &&  !ds->lst )  ||
+        ( Plan.xn  &&  ( !ds->xb  ||  !Plan.xk ) )  ||  ( Plan.sk  &&  !ds->sb ) )
+   {
+      dump_close( ds );
+
+      printf( "  error %i allocating dump buffers\n", ENOMEM );
+      printf( "  (%s)\n", strerror( ENOMEM ) );
+
+      return ( ENOMEM );
+   }
+
+   return ( 0 );
+}
+
+
+void  dump_close( struct dmps* ds )
+{
+   if ( ds->byt )  free( ds->byt );
+   if ( ds->txt )  free( ds->txt );
+   if ( ds->lst )  free( ds->lst );
+   if ( ds->xb )  free( ds->xb );
+   if ( ds->sb )  free( ds->sb );
+
+   ds->byt = NULL;
+   ds->txt = NULL;
+   ds->lst = NULL;
+   ds->xb  = NULL;
+   ds->sb  = NULL;
+
+   return;
+}
+
+
+/* dump_bytes - format a block of input bytes into dump lines */
+
+void  dump_bytes( FILE* fpo, struct dmps* ds, unsigned char* buf, long long n )
+{
+   long long  k, now = 0;
+   int        burst = 0;
+
+   if ( Plan.xn  &&  n > 0  &&  buf != ds->xb  &&  buf != ds->sb )
+   {                                                  /* transform them first */
+      if ( Plan.sk  &&  !ds->sset )    /* (-stride: keyed by input offsets) */
+      {
+         ds->sbase = ds->adr;
+         ds->sset = 1;
+      }
+
+      for ( ;  n > 0;  buf += k, n -= k )
+      {
+         k = ( n < XfBuf ? n : XfBuf );
+
+         xf_apply( ds->xb, buf, k,
+                   ( Plan.sk ? ds->sbase + ds->cnt : ds->adr ) );
+         dump_bytes( fpo, ds, ds->xb, k );
+      }
+
+      return;
+   }
+
+   if ( Plan.sk  &&  n > 0  &&  buf != ds->sb )    /* -stride: pick the words */
+   {
+      if ( !ds->sset )  ds->sbase = ds->adr;    /* (the input's offsets) */
+      ds->sset = 1;
+
+      for ( ;  n > 0;  buf += k, n -= k )
+      {
+         int  j;
+
+         k = ( n < XfBuf ? n : XfBuf );
+         j = stride_pick( ds, ds->sb, buf, k );
+
+         if ( j )  dump_bytes( fpo, ds, ds->sb, j );
+
+         ds->cnt += k - j;    /* (counting all the input's bytes) */
+      }
+
+      return;
+   }
+
+   if ( Plan.sk )  StrideBase = ds->sbase;    /* (for the addresses) */
+
+   if ( Plan.dec )    /* decoding: text in, bytes out */
+   {
+      dump_dec( fpo, ds, buf, n );
+      return;
+   }
+
+   if ( ds->gap  &&  n > 0 )  dump_note( fpo, ds );
+
+   if ( Stamp  &&  n > 0 )    /* one clock reading for each block read */
+   {
+      now = stamp_clock();
+      burst = 1;
+   }
+
+   while ( n > 0 )
+   {
+      if ( !Plan.per )    /* continuous: one never-ending dump line */
+      {
+         if ( !ds->ix  &&  Stamp )
+         {
+            ds->tln = now;
+            ds->txn += fmt_stamp( &ds->txt[ds->txn], ds, 1 );
+         }
+
+         if ( !ds->ix  &&  LineTag )
+         {
+            memcpy( &ds->txt[ds->txn], LineTag, LineTagN );
+            ds->txn += LineTagN;
+         }
+
+         if ( !ds->ix  &&  AddrNum )
+            ds->txn += fmt_addr( &ds->txt[ds->txn], ds->adr );
+
+         k = ( DumpTxt - ds->txn ) / ( Plan.rw + 7 ) + 1;    /* (a byte's */
+                                                         /* text, gaps, */
+                                                         /* color) */
+         if ( k > n )  k = n;
+
+         if ( Plan.eg )    /* encoding: whole groups (holding the rest) */
+         {
+            int  g = Plan.eg, i = 0, j;
+
+            if ( ds->gn )    /* top up the group held from last time */
+            {
+               i = ( g - ds->gn < k ? g - ds->gn : k );
+               memcpy( &ds->byt[ds->gn], buf, i );
+
+               if ( ( ds->gn += i ) == g )
+               {
+                  ds->txn += fmt_enc( &ds->txt[ds->txn], ds->byt, g );
+                  ds->gn = 0;
+               }
+            }
+
+            j = ( k - i ) / g * g;
+            ds->txn += fmt_enc( &ds->txt[ds->txn], &buf[i], j );
+
+            memcpy( &ds->byt[ds->gn], &buf[ i + j ], k - i - j );
+            ds->gn += k - i - j;
+
+            ds->ix = 1;    /* (the line is started) */
+         }
+         else
+         {
+            ds->txn += fmt_hex( &ds->txt[ds->txn], buf, k, ds->ix );
+            ds->ix += k;
+         }
+      }
+      else if ( !ds->ix  &&  n >= Plan.per )    /* a whole line, in place */
+      {
+         k = Plan.per;
+
+         if ( Plan.sqz  &&  dump_same( ds, buf ) )    /* (a repeated line) */
+         {
+            burst = 0;
+         }
+         else
+         {
+            if ( Stamp )    /* (a burst's first line, or every line) */
+            {
+               ds->tln = now;
+               ds->txn += fmt_stamp( &ds->txt[ds->txn], ds,
+                                     ( burst  ||  !StampBurst ) );
+               burst = 0;
+            }
+
+            ds->txn += fmt_line( &ds->txt[ds->txn], buf, k, ds->adr );
+         }
+      }
+      else    /* gather a line that straddles input blocks */
+      {
+         k = Plan.per - ds->ix;
+         if ( k > n )  k = n;
+
+         if ( Stamp  &&  ( !ds->ix  ||  ( burst  &&  !ds->tmark ) ) )
+         {
+            ds->tln = now;    /* (the line's first byte, or first burst) */
+            ds->tmark = ( burst  ||  !StampBurst );
+         }
+
+         burst = 0;
+
+         memcpy( &ds->byt[ds->ix], buf, k );
+         ds->ix += k;
+
+         if ( ds->ix == Plan.per  &&  Plan.sqz  &&  dump_same( ds, ds->byt ) )
+         {
+            ds->ix = 0;    /* (a repeated line) */
+         }
+         else if ( ds->ix == Plan.per )
+         {
+            if ( Stamp )
+               ds->txn += fmt_stamp( &ds->txt[ds->txn], ds, ds->tmark );
+
+            ds->txn += fmt_line( &ds->txt[ds->txn], ds->byt, Plan.per,
+                                 ds->adr + k - Plan.per );
+            ds->ix = 0;
+         }
+      }
+
+      buf += k;
+      n -= k;
+
+      ds->adr += k;
+      ds->cnt += k;
+
+      if ( ds->txn >= DumpTxt )  dump_emit( fpo, ds );    /* buffer full */
+   }
+
+   if ( ds->txn )  dump_emit( fpo, ds );
+
+   if ( !ds->mp )  dump_flush( fpo );
+
+   return;
+}
+
+
+/* dump_dec - decode base64, base32 or Ascii85 text (white space is */
+/* skipped, as are characters outside the alphabet: counted as bad) */
+
+void  dump_dec( FILE* fpo, struct dmps* ds, unsigned char* buf, long long n )
+{
+   long long  i;
+   int        v, w = ( Enc == 64 ? 4 : Enc == 32 ? 8 : 5 );
+
+   for ( i = 0;  i < n;  i++ )
+   {
+      if ( ( v = Plan.dv[ buf[i] ] ) >= 0 )    /* the next digit */
+      {
+         ds->gv = ds->gv * Enc + v;
+         ds->byt[ ds->gn++ ] = v;
+
+         if ( ds->gn == w )  dec_group( ds );
+      }
+      else if ( v == -2  &&  ds->gn )    /* '=' pads out a short group */
+      {
+         dec_group( ds );
+      }
+      else if ( v == -3  &&  !ds->gn )    /* Ascii85 'z': four zero bytes */
+      {
+         memset( &ds->txt[ds->txn], 0x00, 4 );
+         ds->txn += 4;
+      }
+      else if ( v != -1  &&  v != -2 )    /* (-1: white space) */
+      {
+         ds->bad++;
+      }
+
+      if ( ds->txn >= DumpTxt )  dump_emit( fpo, ds );
+   }
+
+   ds->adr += n;
+   ds->cnt += n;
+
+   if ( ds->txn )  dump_emit( fpo, ds );
+
+   if ( !ds->mp )  dump_flush( fpo );
+
+   return;
+}
+
+
+/* dec_group - write out a decoded group (short ones give fewer bytes) */
+
+void  dec_group( struct dmps* ds )
+{
+   unsigned long long  v = ds->gv;
+
+   int  i, k, n = ds->gn;
+
+   if ( Enc == 64 )    /* 4 digits: 3 bytes */
+   {
+      for ( i = n;  i < 4;  i++ )  v *= 64;
+      k = n * 6 / 8;
+
+      for ( i = 0;  i < k;  i++ )
+         ds->txt[ ds->txn++ ] = v >> ( 16 - 8 * i );
+   }
+   else if ( Enc == 32 )    /* 8 digits: 5 bytes */
+   {
+      for ( i = n;  i < 8;  i++ )  v *= 32;
+      k = n * 5 / 8;
+
+      for ( i = 0;  i < k;  i++ )
+         ds->txt[ ds->txn++ ] = v >> ( 32 - 8 * i );
+   }
+   else    /* Ascii85, 5 digits: 4 bytes (short: padded with 'u') */
+   {
+      for ( i = n;  i < 5;  i++ )  v = v * 85 + 84;
+      k = ( n ? n - 1 : 0 );
+
+      for ( i = 0;  i < k;  i++ )
+         ds->txt[ ds->txn++ ] = v >> ( 24 - 8 * i );
+   }
+
+   ds->gn = 0;
+   ds->gv = 0;
+
+   return;
+}
+
+
+/* xf_apply - the byte transform steps, in order, 8 bytes at a time: the */
+/* -xor key (repeated from address 0), -add/-sub (in each byte, without */
+/* carries), -bitrev, and -nibswap */
+
+void  xf_apply( unsigned char* out, unsigned char* in, long long n,
+                long long adr )
+{
+   unsigned long long  w, k, lo = 0x7F7F7F7F7F7F7F7FULL;
+
+   long long  i;
+   int        s, m, p = ( XfKl ? adr % XfKl : 0 );
+
+   for ( s = 0;  s < XfN;  s++, in = out )
+   {
+      k = XfArg[s] * 0x0101010101010101ULL;
+
+      for ( i = 0;  i < n;  i += 8 )
+      {
+         m = ( n - i < 8 ? n - i : 8 );    /* (the last word may be short) */
+
+         if ( m == 8 )  memcpy( &w, &in[i], 8 );
+         else  { w = 0;  memcpy( &w, &in[i], m ); }
+
+         switch ( XfOp[s] )
+         {
+            case 'x':
+               memcpy( &k, &Plan.xk[ p + i ], 8 );
+               w ^= k;
+               break;
+
+            case 'a':
+               w = ( ( w & lo ) + ( k & lo ) ) ^ ( ( w ^ k ) & ~lo );
+               break;
+
+            case 'r':
+               w = ( ( w >> 1 ) & 0x5555555555555555ULL ) |
+                   ( ( w & 0x5555555555555555ULL ) << 1 );
+               w = ( ( w >> 2 ) & 0x3333333333333333ULL ) |
+                   ( ( w & 0x3333333333333333ULL ) << 2 );
+               /* fall through - and on, to nibbles */
+
+            case 'n':
+               w = ( ( w >> 4 ) & 0x0F0F0F0F0F0F0F0FULL ) |
+                   ( ( w & 0x0F0F0F0F0F0F0F0FULL ) << 4 );
+               break;
+         }
+
+         memcpy( &out[i], &w, m );
+      }
+   }
+
+   return;
+}
+
+
+/* stride_pick - copy out the -stride words of a block (word sp of every */
+/* sk): whole runs of sk words go by a fixed-size copy each, and the ends */
+/* (words split between blocks) a piece at a time; the count copied */
+
+int  stride_pick( struct dmps* ds, unsigned char* out, unsigned char* in,
+                  int n )
+{
+   int  i = 0, j = 0, d, w = Plan.sw, per = Plan.sk * w, lo = Plan.sp * w;
+
+   while ( i < n )
+   {
+      if ( !ds->spos  &&  w <= 8 )    /* (the gather: whole periods) */
+      {
+         for ( ;  i + per <= n;  i += per, j += w )
+         {
+            if ( w == 1 )  out[j] = in[ i + lo ];
+            else if ( w == 2 )  memcpy( &out[j], &in[ i + lo ], 2 );
+            else if ( w == 4 )  memcpy( &out[j], &in[ i + lo ], 4 );
+            else  memcpy( &out[j], &in[ i + lo ], w );
+         }
+
+         if ( i >= n )  break;
+      }
+
+      if ( ds->spos < lo )    /* before the word */
+      {
+         d = lo - ds->spos;
+      }
+      else if ( ds->spos < lo + w )    /* in it */
+      {
+         d = lo + w - ds->spos;
+         if ( d > n - i )  d = n - i;
+
+         memcpy( &out[j], &in[i], d );
+         j += d;
+      }
+      else    /* after it */
+      {
+         d = per - ds->spos;
+      }
+
+      if ( d > n - i )  d = n - i;
+
+      i += d;
+      ds->spos = ( ds->spos + d ) % per;
+   }
+
+   return ( j );
+}
+
+
+/* dump_same - od squeezing: is this whole line a repeat of the last one? */
+/* (the first repeat shows as a "*" line, and the rest are left out) */
+
+int  dump_same( struct dmps* ds, unsigned char* p )
+{
+   if ( ds->lsn  &&  !memcmp( ds->lst, p, Plan.per ) )
+   {
+      if ( !ds->rep )
+      {
+         ds->txt[ds->txn++] = '*';
+         ds->txt[ds->txn++] = '\n';
+      }
+
+      ds->rep = 1;
+
+      return ( 1 );
+   }
+
+   memcpy( ds->lst, p, Plan.per );
+
+   ds->lsn = 1;
+   ds->rep = 0;
+
+   return ( 0 );
+}
+
+
+/* dump_end - finish off the final (partial) dump line */
+
+void  dump_end( FILE* fpo, struct dmps* ds )
+{
+   if ( ds->gap )  dump_note( fpo, ds );
+
+   if ( Plan.sk )  StrideBase = ds->sbase;
+
+   if ( Plan.dec )    /* decoding: the last (short) group */
+   {
+      if ( ds->gn )  dec_group( ds );
+      if ( ds->txn )  dump_emit( fpo, ds );
+
+      __atomic_add_fetch( &DecBad, ds->bad, __ATOMIC_SEQ_CST );
+
+      return;
+   }
+
+   if ( !ds->ix )  return;
+
+   if ( !Plan.per  &&  ds->gn )    /* encoding: the last (short) group */
+   {
+      ds->txn += fmt_enc( &ds->txt[ds->txn], ds->byt, ds->gn );
+      ds->gn = 0;
+   }
+
+   if ( Plan.per  &&  Stamp )
+      ds->txn += fmt_stamp( &ds->txt[ds->txn], ds, ds->tmark );
+
+   if ( Plan.per )
+      ds->txn += fmt_line( &ds->txt[ds->txn], ds->byt, ds->ix,
+                           ds->adr - ds->ix );
+   else
+      ds->txt[ds->txn++] = '\n';
+
+   dump_emit( fpo, ds );
+
+   ds->ix = 0;
+
+   if ( !ds->mp )  dump_flush( fpo );
+
+   return;
+}
+
+
+/* dump_emit - write out the staged dump text (or pass it to the writer) */
+
+void  dump_emit( FILE* fpo, struct dmps* ds )
+{
+   if ( ds->mp )    /* +mt: swap in an empty text block */
+   {
+      ds->tb->n = ds->txn;
+      ring_put( &ds->mp->out, ds->tb );
+
+      ds->tb = ring_get( &ds->mp->outf );
+      ds->txt = (char*) ds->tb->buf;
+   }
+   else
+   {
+      fwrite( ds->txt, 1, ds->txn, fpo );
+   }
+
+   ds->txn = 0;
+
+   return;
+}
+
+
+/* dump_flush - apply the -u flush policy to newly written dump lines */
+
+void  dump_flush( FILE* fpo )
+{
+   if ( Flush == 1 )    /* every complete line goes out right away */
+      fflush( fpo );
+   else if ( Flush )    /* flushed once the input goes idle (read_fd) */
+      FlushOut = fpo;
+
+   return;
+}
+
+
+/* dump_gap - skip over n bytes of the stream (reported as a note line) */
+
+void  dump_gap( FILE* fpo, struct dmps* ds, long long n, char* why )
+{
+   if ( ds->gap  &&  ds->why != why )  dump_note( fpo, ds );
+
+   if ( !ds->gap )  dump_end( fpo, ds );    /* finish the partial line */
+
+   ds->gap += n;
+   ds->why = why;
+
+   ds->adr += n;
+   ds->cnt += n;
+
+   return;
+}
+
+
+/* dump_note - report the skipped bytes (in order with the lines: +mt) */
+
+void  dump_note( FILE* fpo, struct dmps* ds )
+{
+   if ( ds->txn )  dump_emit( fpo, ds );    /* (the lines before it) */
+
+   ds->txn = snprintf( ds->txt, DumpTxt, "    (%s: %llx-%llx, %lli byte%s "
+                       "skipped)\n", ds->why, ds->adr - ds->gap, ds->adr,
+                       ds->gap, ss( ds->gap == 1 ) );
+   ds->gap = 0;
+
+   dump_emit( fpo, ds );
+
+   return;
+}
+
+
+/* plan_make - lay out the dump line for the current options: the most */
+/* text any line can take (to size the line buffers), the hex portion's */
+/* width (to blank-fill a short last line), and the ASCII column map */
+
+void  plan_make()
+{
+   struct fplan  *p = &Plan;
+
+   int  ch;
+
+   p->per = ( PerLine > 0 ? PerLine : 0 );
+
+   p->pre = MuxTag + 4 + 17 + 18 + 23;    /* tag, stamp, address, sector */
+
+   /* -r#: the digits for each byte (only in dmp's own format) */
+
+   p->rw = ( Emul  ||  Radix == 16 ? 2 : Radix == 2 ? 8 : 3 );
+
+   for ( ch = 0;  p->rw > 2  &&  ch < 256;  ch++ )
+   {
+      int  i, d = ch;
+
+      for ( i = p->rw - 1;  i >= 0;  i--, d /= Radix )
+         p->rd[ch][i] = ( Radix == 10  &&  !d  &&  i < 2 ? ' ' : '0' + d % Radix );
+   }
+
+   p->hex = ( HexDump ? p->rw * p->per : 0 );
+
+   /* -y: whole typed words per line, each in a fixed-width column */
+
+   p->tw = ( !Emul  &&  HexDump ? WBits / 8 : 0 );
+   p->tk = WType;
+   p->tbe = WBig;
+
+   if ( p->tw  &&  ( !p->per  ||  p->per % p->tw ) )    /* (-p# is kept) */
+      p->per = ( p->per ? p->per + p->tw - p->per % p->tw : 16 );
+
+   if ( p->tw )
+   {
+      static int  cw[4][4] =    /* 8, 16, 32, 64 bits: u, s, x, f */
+         { { 3, 4, 2, 0 }, { 5, 6, 4, 0 }, { 10, 11, 8, 15 },
+           { 20, 20, 16, 24 } };
+
+      p->tc = cw[ p->tw == 8 ? 3 : p->tw / 2 ][ strchr( "usxf", p->tk ) - "usxf" ];
+   }
+
+   if ( HexDump  &&  WordLen )  p->hex += p->per / WordLen;
+   if ( HexDump  &&  HalfGap )  p->hex += p->per / HalfGap;
+
+   if ( p->tw )  p->hex = p->per / p->tw * ( p->tc + 1 );
+
+   p->cin = ( Emul == 'i' );    /* (xxd -i: "0x2f, " for each byte) */
+   p->cw = ( Emul == 'c' ? CcWord : 0 );
+   p->cbe = CcBig;
+
+   if ( p->cw > 1  &&  p->per % p->cw )    /* (-cc: whole words per line) */
+      p->per += p->cw - p->per % p->cw;
+
+   if ( p->cin  ||  p->cw )  p->hex = 6 * p->per + 8;
+
+   /* -base64, -base32, -ascii85: whole groups per line, and the tables */
+
+   p->eg = ( Emul == 'e' ? ( Enc == 64 ? 3 : Enc == 32 ? 5 : 4 ) : 0 );
+   p->dec = ( Emul == 'd' );
+
+   if ( p->eg  &&  p->per % p->eg )  p->per += p->eg - p->per % p->eg;
+
+   if ( p->eg )  p->hex = 2 * p->per + 8;
+
+   if ( p->eg  ||  p->dec )
+   {
+      p->ea = ( Enc == 64 ?
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+                : Enc == 32 ? "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567" : NULL );
+
+      for ( ch = 0;  Enc == 64  &&  ch < 4096;  ch++ )
+      {
+         p->e64[ch][0] = p->ea[ ch >> 6 ];
+         p->e64[ch][1] = p->ea[ ch & 63 ];
+      }
+
+      for ( ch = 0;  ch < 256;  ch++ )
+      {
+         if ( Enc == 85 )
+            p->dv[ch] = ( ch >= '!'  &&  ch <= 'u' ? ch - '!' : -4 );
+         else
+            p->dv[ch] = ( strchr( p->ea, ch )  &&  ch ?
+                          strchr( p->ea, ch ) - p->ea : -4 );
+
+         if ( isspace( ch ) )  p->dv[ch] = -1;
+         if ( ch == '='  &&  Enc != 85 )  p->dv[ch] = -2;
+         if ( ch == 'z'  &&  Enc == 85 )  p->dv[ch] = -3;
+      }
+   }
+
+   for ( ch = 0;  p->cw  &&  ch < 256;  ch++ )
+   {
+      memcpy( p->ci[ch], "0x00, ", 6 );
+
+      p->ci[ch][2] = ( LoCase ? HexLo : HexUp )[ ch >> 4 ];
+      p->ci[ch][3] = ( LoCase ? HexLo : HexUp )[ ch & 15 ];
+   }
+
+   p->u8 = ( TextCode == 'u' );
+
+   p->line = p->pre + p->hex + 2 + ( Ascii ? p->per + 2 : 0 ) + 1;
+
+   if ( Ascii  &&  p->u8 )  p->line += 3 * p->per / 4 + 1;    /* (7 per 4-byte */
+                                                             /* character) */
+   if ( Ascii  &&  TextCode  &&  !p->u8 )  p->line += p->per;    /* (Latin-1) */
+
+   /* byte transforms: the -xor key, repeated over a whole block (and a */
+   /* key's length more, for a block starting part way into the key) */
+
+   p->xn = XfN;
+
+   if ( p->xn  &&  !p->xk )  p->xk = malloc( XfBuf + XfKey + 8 );
+
+   for ( ch = 0;  p->xk  &&  XfKl  &&  ch < XfBuf + XfKey + 8;  ch++ )
+      p->xk[ch] = XfKeyB[ ch % XfKl ];
+
+   /* -stride: words of the -b/-w (or -y) group size */
+
+   p->sk = Stride;
+   p->sp = StridePh;
+   p->sw = ( WBits ? WBits / 8 : WordLen > 0 ? WordLen : 1 );
+
+   /* -color: each byte's class, and its escape and digits ready to copy */
+
+   p->col = ( Color > 0  ||  ( Color < 0  &&  !Emul  &&  !ToFile  &&
+                               isatty( STDOUT_FILENO ) ) );
+
+   if ( p->eg  ||  p->dec  ||  p->cw  ||  p->cin )  p->col = 0;
+
+   for ( ch = 0;  p->col  &&  ch < 256;  ch++ )
+   {
+      p->cls[ch] = ( !ch ? 0 : ch == ' '  ||  ( ch >= '\t'  &&  ch <= '\r' ) ?
+                     2 : ch < ' '  ||  ch == 0x7F ? 3 : ch > 0x7F ? 4 : 1 );
+
+      memcpy( p->ch[ch], "\033[90m", 5 );    /* NUL: gray, printable: cyan, */
+      p->ch[ch][3] = "06253"[ (int) p->cls[ch] ];    /* space: green, control: */
+      if ( p->cls[ch] )  p->ch[ch][2] = '3';            /* magenta, high: yellow */
+
+      memcpy( p->esc[ (int) p->cls[ch] ], p->ch[ch], 5 );
+
+      p->ch[ch][5] = ( LoCase ? HexLo : HexUp )[ ch >> 4 ];
+      p->ch[ch][6] = ( LoCase ? HexLo : HexUp )[ ch & 15 ];
+   }
+
+   if ( p->col )  p->line += 12 * p->per + 24;    /* (escapes at every byte) */
+
+   if ( !p->per )  p->line += p->rw + 2;    /* (continuous: a byte over) */
+   if ( p->rw > 2 )  p->line += 8;    /* (fmt_hex's 8-byte digit copies) */
+
+   /* the address and ASCII column trimmings of the emulated tools */
+
+   p->amin = ( Emul == 'o' ? 6 : AddrNum == 2 ? 8 : 4 );
+   p->emin = ( Emul == 'o' ? 6 : 8 );
+   p->sqz = ( Emul == 'o' );
+
+   strcpy( p->asep, ( Emul == 'x' ? ": " : Emul == 'o' ? " " : "  " ) );
+
+   p->abar[0] = ( Emul == 'x' ? 0 : Emul == 'o' ? '>' : '|' );
+   p->abar[1] = ( Emul == 'x' ? 0 : Emul == 'o' ? '<' : '|' );
+
+   /* the text column's character for each byte: by the ASCII rules, or */
+   /* from a code page (-a:latin1, -a:ebcdic037, -a=file) as Latin-1 */
+
+   p->ax = 0;
+
+   for ( ch = 0;  ch < 256;  ch++ )
+   {
+      int  c = ( TextCode == 'l' ? ch : TextCode == 'e' ? Ebc037[ch] :
+                 TextCode == 'i' ? Ebc500[ch] : TextCode == 'f' ? TextMap[ch] :
+                 -1 );
+
+      if ( c >= 0 )    /* (controls, and the soft hyphen, as '.') */
+         p->asc[ch] = ( c < ' '  ||  ( c >= 0x7F  &&  c < 0xA0 )  ||
+                        c == 0xAD ? '.' : c );
+      else if ( ch == '\0'  &&  !Emul )    /* (the tools show NUL as '.') */
+         p->asc[ch] = '_';
+      else if ( ch < ' '  ||  ch > '~' )
+         p->asc[ch] = '.';
+      else
+         p->asc[ch] = ch;
+
+      if ( p->asc[ch] & 0x80 )  p->ax = 1;
+   }
+
+   return;
+}
+
+
+/* fmt_addr - render the line/address number (per AddrNum) */
+/* (kept as a hex text counter: the next line's address is the last one */
+/* plus a few digit carries, so most lines need only a few byte stores) */
+
+int  fmt_addr( char* out, long long adr )
+{
+   static __thread char       hex[16];         /* the address: 16 digits */
+   static __thread long long  last = -1;       /*   (for this address) */
+   static __thread int        top = 15, up;    /*   (first significant one) */
+
+   long long  d;
+   char       *dig = ( LoCase ? HexLo : HexUp );
+   int        i, c, w, n;
+
+   if ( Plan.sk )    /* -stride: the word's offset in the input */
+   {
+      d = adr - StrideBase;
+      adr = StrideBase + ( d / Plan.sw * Plan.sk + Plan.sp ) * Plan.sw +
+            d % Plan.sw;
+   }
+
+   if ( last < 0  ||  adr < last  ||  up != LoCase )    /* start over */
+   {
+      for ( i = 15, d = adr;  i >= 0;  i--, d >>= 4 )  hex[i] = dig[ d & 15 ];
+
+      for ( top = 0;  top < 15  &&  hex[top] == '0';  top++ )  ;
+
+      up = LoCase;
+   }
+   else    /* add the step, carrying only through the changed digits */
+   {
+      for ( i = 15, d = adr - last, c = 0;  d  ||  c;  i--, d >>= 4 )
+      {
+         c += ( hex[i] <= '9' ? hex[i] - '0' : ( hex[i] | 0x20 ) - 'a' + 10 )
+              + ( d & 15 );
+         hex[i] = dig[ c & 15 ];
+         c >>= 4;
+      }
+
+      if ( i + 1 < top )  top = i + 1;    /* (carried into a new digit) */
+   }
+
+   last = adr;
+
+   /* n1: 4+ digits, n2: 8+ digits, n3: 4+ digits right-justified in 8 */
+
+   w = 16 - top;
+   n = 0;
+
+   if ( AddrNum == 3 )
+      for ( ;  n + ( w > 4 ? w : 4 ) < 8;  n++ )  out[n] = ' ';
+
+   if ( w < Plan.amin )  w = Plan.amin;
+
+   if ( AddrNum )
+   {
+      memcpy( &out[n], &hex[ 16 - w ], w );
+      n += w;
+
+      for ( w = 0;  Plan.asep[w];  w++ )  out[n++] = Plan.asep[w];
+   }
+
+   if ( Sectors  &&  n )    /* the sector number, alongside the address */
+   {
+      out[n++] = '#';
+      n += fmt_dec( &out[n], adr / SecSize, 8, '0' );
+      out[n++] = ' ';
+      out[n++] = ' ';
+   }
+
+   return ( n );
+}
+
+
+/* fmt_cc - render a -cc line: C array items (bytes from the plan's */
+/* "0x2f, " table, or words), or the next piece of a string literal */
+
+int  fmt_cc( char* out, unsigned char* byt, int n )
+{
+   char  *op = out;
+   int   ch, i, j, k, w = Plan.cw;
+
+   if ( w < 0 )    /* "...": printable characters as is, the rest in octal */
+   {
+      memcpy( op, "\n  \"", 4 );
+      op += 4;
+
+      for ( i = 0;  i < n;  i++ )
+      {
+         ch = byt[i];
+
+         if ( ch >= ' '  &&  ch <= '~'  &&  ch != '"'  &&  ch != '\\'  &&
+              ch != '?' )    /* (no trigraphs) */
+         {
+            *op++ = ch;
+         }
+         else
+         {
+            *op++ = '\\';
+            *op++ = '0' + ( ch >> 6 );
+            *op++ = '0' + ( ( ch >> 3 ) & 7 );
+            *op++ = '0' + ( ch & 7 );
+         }
+      }
+
+      *op++ = '"';
+
+      return ( op - out );    /* (the next piece, or the footer, ends it) */
+   }
+
+   *op++ = ' ';
+   *op++ = ' ';
+
+   if ( w == 1 )
+   {
+      for ( i = 0;  i < n;  i++, op += 6 )  memcpy( op, Plan.ci[ byt[i] ], 6 );
+   }
+   else    /* words: most significant byte first (a short last one: 0s) */
+   {
+      for ( i = 0;  i < n;  i += w )
+      {
+         *op++ = '0';
+         *op++ = 'x';
+
+         for ( j = 0;  j < w;  j++, op += 2 )
+         {
+            k = ( Plan.cbe ? i + j : i + w - 1 - j );
+            memcpy( op, &Plan.ci[ k < n ? byt[k] : 0 ][2], 2 );
+         }
+
+         *op++ = ',';
+         *op++ = ' ';
+      }
+   }
+
+   op[-1] = '\n';    /* (every item has its ',', the last one too) */
+
+   return ( op - out );
+}
+
+
+/* fmt_enc - encode n bytes as base64, base32 or Ascii85 ('z' for a group */
+/* of zeros); a short last group is padded with '=' (Ascii85: cut short) */
+
+int  fmt_enc( char* out, unsigned char* byt, int n )
+{
+   unsigned long long  v;
+
+   char  *op = out, *ea = Plan.ea;
+   int   i, j, r;
+
+   if ( Enc == 64 )    /* 3 bytes: two 12-bit table pairs */
+   {
+      for ( i = 0;  i + 3 <= n;  i += 3, op += 4 )
+      {
+         v = byt[i] << 16 | byt[ i + 1 ] << 8 | byt[ i + 2 ];
+
+         memcpy( op, Plan.e64[ v >> 12 ], 2 );
+         memcpy( &op[2], Plan.e64[ v & 4095 ], 2 );
+      }
+
+      if ( ( r = n - i ) )
+      {
+         v = byt[i] << 16 | ( r > 1 ? byt[ i + 1 ] << 8 : 0 );
+
+         memcpy( op, Plan.e64[ v >> 12 ], 2 );
+         op[2] = ( r > 1 ? ea[ ( v >> 6 ) & 63 ] : '=' );
+         op[3] = '=';
+         op += 4;
+      }
+   }
+   else if ( Enc == 32 )    /* 5 bytes: 8 digits of 5 bits */
+   {
+      for ( i = 0;  i < n;  i += 5, op += 8 )
+      {
+         r = ( n - i < 5 ? n - i : 5 );
+
+         for ( v = 0, j = 0;  j < 5;  j++ )  v = v << 8 | ( j < r ? byt[ i + j ] : 0 );
+
+         for ( j = 0;  j < 8;  j++ )    /* (short: just the digits used) */
+            op[j] = ( j < ( r * 8 + 4 ) / 5 ? ea[ ( v >> ( 35 - 5 * j ) ) & 31 ]
+                                            : '=' );
+      }
+   }
+   else    /* Ascii85, 4 bytes: 5 digits from '!' */
+   {
+      for ( i = 0;  i < n;  i += 4 )
+      {
+         r = ( n - i < 4 ? n - i : 4 );
+
+         for ( v = 0, j = 0;  j < 4;  j++ )  v = v << 8 | ( j < r ? byt[ i + j ] : 0 );
+
+         if ( !v  &&  r == 4 )
+         {
+            *op++ = 'z';
+            continue;
+         }
+
+         for ( j = 4;  j >= 0;  j--, v /= 85 )  op[j] = '!' + v % 85;
+
+         op += r + 1;
+      }
+   }
+
+   return ( op - out );
+}
+
+
+/* fmt_stamp - render a line's time stamp (or blanks, to keep the columns) */
+
+int  fmt_stamp( char* out, struct dmps* ds, int show )
+{
+   static __thread long long  sec = -1;
+   static __thread char       hms[8];
+
+   struct tm  tm;
+   time_t     tt;
+
+   char       *op = out;
+   long long  t;
+
+   if ( !show )
+   {
+      t = ( StampFmt == 'a' ? 17 : 15 );
+      memset( out, ' ', t );
+
+      return ( t );
+   }
+
+   if ( StampFmt == 'a' )    /* time of day, from the offset to the wall clock */
+   {
+      t = ds->tln + StampWall;
+
+      if ( t / 1000000000 != sec )    /* (local time changes once a second) */
+      {
+         sec = t / 1000000000;
+         tt = sec;
+
+         localtime_r( &tt, &tm );
+
+         fmt_dec( &hms[0], tm.tm_hour, 2, '0' );
+         fmt_dec( &hms[3], tm.tm_min, 2, '0' );
+         fmt_dec( &hms[6], tm.tm_sec, 2, '0' );
+         hms[2] = hms[5] = ':';
+      }
+
+      memcpy( op, hms, 8 );
+      op += 8;
+   }
+   else if ( StampFmt == 'd' )    /* time since the previous stamp */
+   {
+      t = ds->tln - ds->tprv;
+
+      *op++ = '+';
+      op += fmt_dec( op, t / 1000000000, 5, ' ' );
+   }
+   else    /* time since the dump started */
+   {
+      t = ds->tln - ds->tbeg;
+
+      op += fmt_dec( op, t / 1000000000, 6, ' ' );
+   }
+
+   *op++ = '.';
+   op += fmt_dec( op, ( t % 1000000000 ) / 1000, 6, '0' );
+   *op++ = ' ';
+   *op++ = ' ';
+
+   ds->tprv = ds->tln;
+
+   return ( op - out );
+}
+
+
+/* fmt_dec - render a decimal number, two digits at a time (right-justified) */
+
+int  fmt_dec( char* out, unsigned long long v, int width, char pad )
+{
+   static __thread char  dig[200];
+
+   char  tmp[24], *tp = &tmp[sizeof(tmp)];
+   int   i, n;
+
+   if ( !dig[0] )
+   {
+      for ( i = 0;  i < 100;  i++ )
+      {
+         dig[ i * 2 ] = '0' + i / 10;
+         dig[ i * 2 + 1 ] = '0' + i % 10;
+      }
+   }
+
+   for ( ;  v >= 100;  v /= 100 )
+   {
+      tp -= 2;
+      memcpy( tp, &dig[ ( v % 100 ) * 2 ], 2 );
+   }
+
+   if ( v >= 10 )
+   {
+      tp -= 2;
+      memcpy( tp, &dig[ v * 2 ], 2 );
+   }
+   else
+   {
+      *--tp = '0' + v;
+   }
+
+   for ( n = &tmp[sizeof(tmp)] - tp;  n < width;  n++ )  *--tp = pad;
+
+   memcpy( out, tp, n );
+
+   return ( n );
+}
+
+
+/* stamp_clock - the time stamp clock (monotonic, in nanoseconds; vDSO) */
+
+long long  stamp_clock()
+{
+   struct timespec  ts;
+
+   clock_gettime( CLOCK_MONOTONIC_RAW, &ts );
+
+   return ( ts.tv_sec * 1000000000LL + ts.tv_nsec );
+}
+
+
+/* stamp_wall - find the offset from stamp_clock() to the wall clock (once) */
+
+void  stamp_wall()
+{
+   struct timespec  ts;
+
+   if ( StampWall )  return;
+
+   clock_gettime( CLOCK_REALTIME, &ts );
+
+   StampWall = ts.tv_sec * 1000000000LL + ts.tv_nsec - stamp_clock();
+
+   return;
+}
+
+
+/* col_off - end a colored stretch of a line (back to the plain colors) */
+
+int  col_off( char* out )
+{
+   memcpy( out, "\033[0m", 4 );
+
+   return ( 4 );
+}
+
+
+/* fmt_hex - render hex digits (and group gaps) for n bytes at line index ix */
+/* (or -r# octal, decimal, or binary digits, from the plan's digit table) */
+
+int  fmt_hex( char* out, unsigned char* byt, long long n, int ix )
+{
+   char  *op = out, *hx = ( LoCase ? HexLo : HexUp );
+   int   c, w = Plan.rw;
+
+   if ( !HexDump )  return ( 0 );
+
+   if ( w > 2 )
+   {
+      for ( c = -1;  n > 0;  n--, byt++ )
+      {
+         if ( Plan.col  &&  Plan.cls[ *byt ] != c )    /* (a new class) */
+         {
+            c = Plan.cls[ *byt ];
+            memcpy( op, Plan.esc[c], 5 );
+            op += 5;
+         }
+
+         memcpy( op, Plan.rd[ *byt ], 8 );    /* (a fixed-size copy) */
+         op += w;
+
+         ix++;
+
+         if ( WordLen  &&  ( ix % WordLen ) == 0 )  *op++ = ' ';
+         if ( HalfGap  &&  ( ix % HalfGap ) == 0 )  *op++ = ' ';
+      }
+
+      if ( Plan.col )  op += col_off( op );
+
+      return ( op - out );
+   }
+
+   if ( Plan.col )    /* escape and digits as the class changes, else digits */
+   {
+      for ( c = -1;  n > 0;  n--, byt++ )
+      {
+         if ( Plan.cls[ *byt ] != c )
+         {
+            c = Plan.cls[ *byt ];
+            memcpy( op, Plan.ch[ *byt ], 8 );
+            op += 7;
+         }
+         else
+         {
+            memcpy( op, &Plan.ch[ *byt ][5], 2 );
+            op += 2;
+         }
+
+         ix++;
+
+         if ( WordLen  &&  ( ix % WordLen ) == 0 )  *op++ = ' ';
+         if ( HalfGap  &&  ( ix % HalfGap ) == 0 )  *op++ = ' ';
+      }
+
+      return ( op - out + col_off( op ) );
+   }
+
+   for ( ;  n > 0;  n--, byt++ )
+   {
+      *op++ = hx[ *byt >> 4 ];
+      *op++ = hx[ *byt & 15 ];
+
+      ix++;
+
+      if ( WordLen  &&  ( ix % WordLen ) == 0 )  *op++ = ' ';
+      if ( HalfGap  &&  ( ix % HalfGap ) == 0 )  *op++ = ' ';
+   }
+
+   return ( op - out );
+}
+
+
+/* fmt_word - render -y typed words: each word's bytes (swapped when the */
+/* byte order isn't the host's) as hex, decimal, or a float; a short word */
+/* left at the end of the file is shown as hex bytes */
+
+int  fmt_word( char* out, unsigned char* byt, int n )
+{
+   unsigned long long  v = 0;
+
+   char  *op = out, *hx = ( LoCase ? HexLo : HexUp );
+   int   i, k, w = Plan.tw, big = Plan.tbe;
+
+   for ( ;  n >= w;  n -= w, byt += w )
+   {
+      if ( w == 1 )  v = *byt;    /* (load the word, in host order) */
+      else if ( w == 2 )  { unsigned short  h;  memcpy( &h, byt, 2 );  v = h; }
+      else if ( w == 4 )  { unsigned int  h;  memcpy( &h, byt, 4 );  v = h; }
+      else  memcpy( &v, byt, 8 );
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      if ( big )
+#else
+      if ( !big )
+#endif
+         v = ( w == 2 ? __builtin_bswap16( v ) : w == 4 ? __builtin_bswap32( v ) :
+               w == 8 ? __builtin_bswap64( v ) : v );
+
+      if ( Plan.tk == 'x' )
+      {
+         for ( i = w * 2 - 1;  i >= 0;  i--, v >>= 4 )  op[i] = hx[ v & 15 ];
+         op += w * 2;
+      }
+      else if ( Plan.tk == 'u' )
+      {
+         op += fmt_dec( op, v, Plan.tc, ' ' );
+      }
+      else if ( Plan.tk == 's' )
+      {
+         long long  sv = ( w == 1 ? (signed char) v : w == 2 ? (short) v :
+                           w == 4 ? (int) v : (long long) v );
+         char       tmp[24];
+
+         if ( sv >= 0 )
+         {
+            op += fmt_dec( op, sv, Plan.tc, ' ' );
+         }
+         else
+         {
+            k = fmt_dec( tmp, - (unsigned long long) sv, 0, ' ' );
+
+            for ( i = k + 1;  i < Plan.tc;  i++ )  *op++ = ' ';
+
+            *op++ = '-';
+            memcpy( op, tmp, k );
+            op += k;
+         }
+      }
+      else    /* f: float or double */
+      {
+         if ( w == 4 )
+         {
+            unsigned int  h = v;
+            float         f;
+
+            memcpy( &f, &h, 4 );
+            op += fmt_flt( op, f, 1 );
+         }
+         else
+         {
+            double  d;
+
+            memcpy( &d, &v, 8 );
+            op += fmt_flt( op, d, 0 );
+         }
+      }
+
+      *op++ = ' ';
+   }
+
+   for ( ;  n > 0;  n--, byt++ )    /* (the bytes of a short last word) */
+   {
+      *op++ = hx[ *byt >> 4 ];
+      *op++ = hx[ *byt & 15 ];
+   }
+
+   return ( op - out );
+}
+
+
+/* fmt_flt - render a float (or double) right-justified in its column, */
+/* with the fewest digits that read back as the same value: each digit */
+/* count's nearest decimal is scaled out in long double and checked */
+/* against the halfway points to the neighboring values (printf only */
+/* settles the rare candidate too near a halfway point to call) */
+
+int  fmt_flt( char* out, double v, int f32 )
+{
+   static __thread long double  p10[360];    /* 10^0 .. 10^359 */
+
+   unsigned long long  b, c = 0, cd;
+
+   long double  a, x, y, lo, hi, m;
+   char         tmp[40], dig[24], *tp = tmp;
+   int          i, k, p, q, d, ok, pm = ( f32 ? 9 : 17 ), e10, ed, ee = 0, nd = 0;
+
+   if ( p10[0] == 0 )
+   {
+      for ( p10[0] = 1, i = 1;  i < 28;  i++ )  p10[i] = p10[ i - 1 ] * 10;
+
+      for ( ;  i < 360;  i++ )  p10[i] = p10[ i - 27 ] * p10[27];    /* (few */
+   }                                                                /* roundings) */
+
+   if ( v != v  ||  v - v != 0  ||  v == 0 )    /* NaN, infinity, zero */
+   {
+      snprintf( tmp, sizeof(tmp), "%g", v );
+      nd = -1;
+   }
+   else
+   {
+      a = ( v < 0 ? -v : v );
+
+      /* the halfway points to the next value down and the next one up */
+
+      if ( f32 )
+      {
+         float         f = a, g;
+         unsigned int  h;
+
+         memcpy( &h, &f, 4 );
+         h--;  memcpy( &g, &h, 4 );  lo = ( a + g ) / 2;
+         h += 2;  memcpy( &g, &h, 4 );  hi = ( a + g ) / 2;
+      }
+      else
+      {
+         double  d = a, g;
+
+         memcpy( &b, &d, 8 );
+         b--;  memcpy( &g, &b, 8 );  lo = ( a + g ) / 2;
+         b += 2;  memcpy( &g, &b, 8 );  hi = ( a + g ) / 2;
+      }
+
+      if ( hi - hi != 0 )  hi = a + ( a - lo );    /* (the largest value) */
+
+      m = a * 32 * LDBL_EPSILON;    /* (the scaling error, and some) */
+
+      x = a;    /* the power of ten: from the binary exponent, then fixed */
+      memcpy( &b, &( double ){ x }, 8 );
+      e10 = ( (int) ( b >> 52 ) - 1023 ) * 78913 >> 18;
+
+      for ( ;  a >= ( e10 < -1 ? 1 / p10[ -e10 - 1 ] : p10[ e10 + 1 ] );  e10++ )  ;
+      for ( ;  a < ( e10 < 0 ? 1 / p10[ -e10 ] : p10[e10] );  e10-- )  ;
+
+      for ( p = 1, q = pm;  p <= q;  )    /* (more digits never do worse) */
+      {
+         d = ( p + q ) / 2;
+         k = d - 1 - e10;    /* a * 10^k: d digits (before rounding) */
+
+         x = ( k >= 0 ? a * p10[k] : a / p10[ -k ] );
+         cd = x + 0.5L;
+         ed = e10;
+
+         if ( cd >= p10[d] )  { cd /= 10;  ed++; }    /* (9.96 -> 10) */
+
+         k = d - 1 - ed;
+         y = ( k >= 0 ? cd / p10[k] : cd * p10[ -k ] );
+
+         ok = ( y > lo + m  &&  y < hi - m );    /* it reads back as v */
+
+         if ( !ok  &&  y > lo - m  &&  y < hi + m )    /* too near to call */
+         {
+            snprintf( tmp, sizeof(tmp), "%.*e", d - 1, (double) a );
+
+            if ( ( ok = ( f32 ? strtof( tmp, NULL ) == (float) a :
+                                strtod( tmp, NULL ) == (double) a ) ) )
+            {
+               for ( cd = 0, i = 0;  tmp[i] != 'e';  i++ )
+                  if ( isdigit( tmp[i] ) )  cd = cd * 10 + tmp[i] - '0';
+
+               ed = atoi( &tmp[ i + 1 ] );
+            }
+         }
+
+         if ( ok )
+         {
+            nd = d;
+            c = cd;
+            ee = ed;
+            q = d - 1;
+         }
+         else
+         {
+            p = d + 1;
+         }
+      }
+
+      if ( !nd )    /* (pm digits always do; this is just belt and braces) */
+      {
+         snprintf( tmp, sizeof(tmp), "%.*g", pm, v );
+         nd = -1;
+      }
+   }
+
+   if ( nd > 0 )    /* lay out the digits like %g, but exponents only for */
+   {                /* the very large (or small) */
+      for ( ;  nd > 1  &&  c % 10 == 0;  nd-- )  c /= 10;
+
+      for ( i = nd - 1;  i >= 0;  i--, c /= 10 )  dig[i] = '0' + c % 10;
+
+      if ( v < 0 )  *tp++ = '-';
+
+      if ( ee < -4  ||  ee >= pm )    /* d.ddde+xx */
+      {
+         *tp++ = dig[0];
+         if ( nd > 1 )  *tp++ = '.';
+
+         memcpy( tp, &dig[1], nd - 1 );
+         tp += nd - 1;
+
+         tp += sprintf( tp, "e%c%02i", ( ee < 0 ? '-' : '+' ), abs( ee ) );
+      }
+      else if ( ee < 0 )    /* 0.000ddd */
+      {
+         *tp++ = '0';
+         *tp++ = '.';
+
+         for ( i = -1;  i > ee;  i-- )  *tp++ = '0';
+
+         memcpy( tp, dig, nd );
+         tp += nd;
+      }
+      else    /* ddd.ddd (or ddd000) */
+      {
+         for ( i = 0;  i < nd  ||  i <= ee;  i++ )
+         {
+            if ( i == ee + 1 )  *tp++ = '.';
+            *tp++ = ( i < nd ? dig[i] : '0' );
+         }
+      }
+
+      *tp = '\0';
+   }
+
+   k = strlen( tmp );
+
+   for ( i = k;  i < Plan.tc;  i++ )  *out++ = ' ';
+
+   memcpy( out, tmp, k );
+
+   return ( i > k ? i : k );
+}
+
+
+/* fmt_utf8 - render the -a:utf8 text column: each whole, printable UTF-8 */
+/* character at its lead byte, blanks for the rest of its bytes (less one */
+/* for a double-width character), and '.' for anything else (including a */
+/* character split across two lines); runs of ASCII go 8 bytes at a time */
+
+int  fmt_utf8( char* out, unsigned char* byt, int n )
+{
+   static int  lo[5] = { 0, 0, 0x80, 0x800, 0x10000 };    /* (overlongs) */
+
+   unsigned long long  w;
+
+   char  *op = out;
+   int   i, j, k, c, cp;
+
+   for ( i = 0;  i < n;  )
+   {
+      if ( i + 8 <= n )    /* (eight ASCII bytes: a word test) */
+      {
+         memcpy( &w, &byt[i], 8 );
+
+         if ( !( w & 0x8080808080808080ULL ) )
+         {
+            for ( j = 0;  j < 8;  j++ )  *op++ = Plan.asc[ byt[ i + j ] ];
+            i += 8;
+            continue;
+         }
+      }
+
+      c = byt[i];
+
+      k = ( c < 0x80 ? 1 : c < 0xC2 ? 0 : c < 0xE0 ? 2 : c < 0xF0 ? 3 :
+            c < 0xF5 ? 4 : 0 );
+
+      if ( k < 2  ||  i + k > n )    /* ASCII, a stray byte, or cut off */
+      {
+         *op++ = ( k == 1 ? Plan.asc[c] : '.' );
+         i++;
+         continue;
+      }
+
+      for ( cp = c & ( 0x7F >> k ), j = 1;  j < k  &&
+            ( byt[ i + j ] & 0xC0 ) == 0x80;  j++ )
+         cp = cp << 6 | ( byt[ i + j ] & 0x3F );
+
+      if ( j < k  ||  cp < lo[k]  ||  cp > 0x10FFFF  ||    /* (invalid) */
+           ( cp >= 0xD800  &&  cp <= 0xDFFF )  ||
+           cp < 0xA0  ||  ( cp >= 0x300  &&  cp < 0x370 )  ||    /* (not */
+           ( cp >= 0x200B  &&  cp < 0x2010 )  ||                  /* one */
+           ( cp >= 0xFE00  &&  cp < 0xFE10 )  ||  cp == 0xFEFF )  /* column) */
+      {
+         *op++ = '.';
+         i++;
+         continue;
+      }
+
+      memcpy( op, &byt[i], k );
+      op += k;
+
+      j = ( ( cp >= 0x1100  &&  cp < 0x1160 )  ||    /* (double width) */
+            ( cp >= 0x2E80  &&  cp < 0xA4D0 )  ||  ( cp >= 0xAC00  &&
+              cp < 0xD7A4 )  ||  ( cp >= 0xF900  &&  cp < 0xFB00 )  ||
+            ( cp >= 0xFE30  &&  cp < 0xFE50 )  ||  ( cp >= 0xFF00  &&
+              cp < 0xFF61 )  ||  ( cp >= 0xFFE0  &&  cp < 0xFFE7 )  ||
+            ( cp >= 0x1F300  &&  cp < 0x1F650 )  ||  ( cp >= 0x1F900  &&
+              cp < 0x1FA00 )  ||  ( cp >= 0x20000  &&  cp < 0x3FFFE ) );
+
+      for ( j++;  j < k;  j++ )  *op++ = ' ';
+
+      i += k;
+   }
+
+   return ( op - out );
+}
+
+
+/* fmt_line - render one complete dump line (n < PerLine for the last line) */
+
+int  fmt_line( char* out, unsigned char* byt, int n, long long adr )
+{
+   char  *op = out;
+   int   ix;
+
+   if ( LineTag )    /* the stream name, for multiplexed dumps */
+   {
+      memcpy( op, LineTag, LineTagN );
+      op += LineTagN;
+   }
+
+   if ( AddrNum )  op += fmt_addr( op, adr );
+
+   if ( Plan.cw )  return ( op - out + fmt_cc( op, byt, n ) );    /* -cc */
+
+   if ( Plan.eg )    /* -base64, -base32, -ascii85 */
+   {
+      op += fmt_enc( op, byt, n );
+      *op++ = '\n';
+
+      return ( op - out );
+   }
+
+   if ( Plan.cin )    /* xxd -i: C array items, the ',' ending the last line */
+   {
+      char  *hx = ( LoCase ? HexLo : HexUp );
+
+      if ( adr != Start )
+      {
+         *op++ = ',';
+         *op++ = '\n';
+      }
+
+      for ( ix = 0;  ix < n;  ix++ )
+      {
+         *op++ = ( ix ? ',' : ' ' );
+         *op++ = ' ';
+         *op++ = '0';
+         *op++ = 'x';
+         *op++ = hx[ byt[ix] >> 4 ];
+         *op++ = hx[ byt[ix] & 15 ];
+      }
+
+      return ( op - out );    /* (the next line, or the footer, ends it) */
+   }
+
+   ix = ( Plan.tw ? fmt_word( op, byt, n ) : fmt_hex( op, byt, n, 0 ) );
+   op += ix;
+
+   if ( Plan.col  &&  !Plan.tw  &&  HexDump )    /* (the digits' width alone) */
+      ix = n * Plan.rw + ( WordLen ? n / WordLen : 0 ) +
+           ( HalfGap ? n / HalfGap : 0 );
+
+   if ( Ascii )
+   {
+      /* blank-fill the rest of the hex data portion (last line only) */
+
+      for ( ;  ix < Plan.hex;  ix++ )  *op++ = ' ';
+
+      /* separate the hex and ASCII portions */
+
+      if ( HexDump  &&  !( WordLen  &&  HalfGap ) )
+      {
+         *op++ = ' ';
+         if ( !WordLen )  *op++ = ' ';
+      }
+
+      /* write the ASCII portion (blank-filled to justify the right column) */
+
+      if ( Plan.abar[0] )  *op++ = Plan.abar[0];
+
+      if ( Plan.u8 )
+      {
+         op += fmt_utf8( op, byt, n );
+         ix = n;
+      }
+      else if ( Plan.ax  ||  Plan.col )    /* (Latin-1 characters, in UTF-8; */
+      {                                       /* or colored, by class) */
+         int  k = -1;
+
+         for ( ix = 0;  ix < n;  ix++ )
+         {
+            unsigned char  c = Plan.asc[ byt[ix] ];
+
+            if ( Plan.col  &&  Plan.cls[ byt[ix] ] != k )
+            {
+               k = Plan.cls[ byt[ix] ];
+               memcpy( op, Plan.esc[k], 5 );
+               op += 5;
+            }
+
+            if ( c & 0x80 )
+            {
+               *op++ = 0xC0 | c >> 6;
+               *op++ = 0x80 | ( c & 0x3F );
+            }
+            else
+            {
+               *op++ = c;
+            }
+         }
+
+         if ( Plan.col )  op += col_off( op );
+      }
+      else
+      {
+         for ( ix = 0;  ix < n;  ix++ )  *op++ = Plan.asc[ byt[ix] ];
+      }
+
+      for ( ;  AscWide  &&  ix < Plan.per;  ix++ )  *op++ = ' ';
+
+      if ( Plan.abar[1] )  *op++ = Plan.abar[1];
+   }
+
+   *op++ = '\n';
+
+   return ( op - out );
+}
+
+
+/* dump_archive - dump the (selected) members of a tar, tar.gz, or zip file */
+
+int  dump_archive( char* name )
+{
+   unsigned char  mag[4];
+   int            err = 0, fd, n = 0;
+
+   if ( ( fd = open( name, O_RDONLY ) ) < 0 )
+   {
+      err = errno;
+
+      if ( Files )  printf( "\n" );
+      printf( "  error %i opening input file: \"%s\"\n", err, name );
+      printf( "  (%s)\n", strerror( err ) );
+
+      return ( err );
+   }
+
+   ArchName = name;
+   ArchHits = 0;
+   ArchSelHits = 0;
+
+   if ( pread( fd, mag, 4, 0 ) == 4  &&  !memcmp( mag, "PK", 2 ) )
+      err = arch_zip( fd );
+   else
+      err = arch_tar( fd );
+
+   /* report the selections that matched nothing (as -s does) */
+
+   if ( !err  &&  ArchSel  &&  ArchSel[0] )
+   {
+      char  sel[1024], *tok;
+      int   i;
+
+      strncpy( sel, ArchSel, sizeof(sel) - 1 );
+      sel[ sizeof(sel) - 1 ] = '\0';
+
+      for ( i = 0, tok = strtok( sel, "," );  tok;
+            i++, tok = strtok( NULL, "," ) )
+      {
+         if ( i < 64  &&  !( ArchSelHits >> i & 1 ) )
+         {
+            if ( !n++  &&  Files )  printf( "\n" );
+            printf( "  no member \"%s\" in archive: \"%s\"\n", tok, name );
+         }
+      }
+   }
+
+   if ( !err  &&  !ArchHits  &&  !n )
+   {
+      if ( Files )  printf( "\n" );
+      printf( "  no %smembers dumped from archive: \"%s\"\n",
+              ( ArchSel ? "matching " : "" ), name );
+   }
+
+   ArchName = NULL;
+
+   close( fd );
+
+   return ( err );
+}
+
+
+/* arch_member - dump one archive member as though it were a file */
+
+int  arch_member( char* path, int (*rd)( void*, unsigned char*, int ),
+                  void* src )
+{
+   long long  cnt;
+   int        err;
+
+   Name = path;
+
+   if ( ( err = open_files() ) )  return ( err );
+
+   if ( TermFmt )  printf( "\n" );
+
+   dump_header();
+
+   cnt = dump_src( Fpo, rd, src, Start, 0 );
+
+   dump_footer( cnt );
+
+   Files++;
+   ArchHits++;
+
+   return ( 0 );
+}
+
+
+/* arch_want - check a member path against the -ar selections */
+
+int  arch_want( char* path )
+{
+   char  sel[1024], *tok;
+   int   i, ok = 0;
+
+   if ( !ArchSel  ||  !ArchSel[0] )  return ( 1 );    /* everything */
+
+   strncpy( sel, ArchSel, sizeof(sel) - 1 );
+   sel[ sizeof(sel) - 1 ] = '\0';
+
+   for ( i = 0, tok = strtok( sel, "," );  tok;
+         i++, tok = strtok( NULL, "," ) )
+   {
+      if ( !fnmatch( tok, path, 0 ) )    /* (noting each that matched) */
+      {
+         if ( i < 64 )  ArchSelHits |= 1ULL << i;
+         ok = 1;
+      }
+   }
+
+   return ( ok );
+}
+
+
+/* tar (and tar.gz, via zlib's transparent reads) */
+
+struct tarm    /* tar member being read */
+{
+   gzFile     gz;
+   long long  left;    /* member data bytes not yet read */
+};
+
+
+int  tar_read( void* src, unsigned char* buf, int size )
+{
+   struct tarm  *tm = src;
+   int          n;
+
+   if ( size > tm->left )  size = tm->left;
+   if ( size <= 0 )  return ( 0 );
+
+   if ( ( n = gzread( tm->gz, buf, size ) ) > 0 )  tm->left -= n;
+
+   return ( n );
+}
+
+
+/* tar_num - a tar header number: octal, or base-256 (GNU) */
+
+long long  tar_num( unsigned char* fld, int len )
+{
+   long long  val = 0;
+   int        i = 0;
+
+   if ( fld[0] & 0x80 )    /* base-256 */
+   {
+      for ( val = fld[0] & 0x3F, i = 1;  i < len;  i++ )
+         val = ( val << 8 ) | fld[i];
+
+      return ( val );
+   }
+
+   for ( ;  i < len  &&  ( fld[i] == ' '  ||  fld[i] == '0' );  i++ );
+
+   for ( ;  i < len  &&  fld[i] >= '0'  &&  fld[i] <= '7';  i++ )
+      val = ( val << 3 ) + ( fld[i] - '0' );
+
+   return ( val );
+}
+
+
+int  arch_tar( int fd )
+{
+   unsigned char  hdr[512];
+
+   struct tarm  tm;
+
+   char       path[4096], next[4096], *rec, *end;
+   long long  size, sum, chk;
+   int        err = 0, i, n;
+
+   if ( !( tm.gz = gzdopen( dup( fd ), "rb" ) ) )
+   {
+      printf( "  error %i opening archive: \"%s\"\n", ENOMEM, ArchName );
+      printf( "  (%s)\n", strerror( ENOMEM ) );
+
+      return ( ENOMEM );
+   }
+
+   gzbuffer( tm.gz, ArchBuf );
+
+   next[0] = '\0';
+
+   while ( !err  &&  gzread( tm.gz, hdr, sizeof(hdr) ) == sizeof(hdr) )
+   {
+      if ( !hdr[0] )  break;    /* end-of-archive (zero block) */
+
+      /* verify the header checksum (the checksum field counts as blanks) */
+
+      chk = tar_num( &hdr[148], 8 );
+
+      for ( sum = 0, i = 0;  i < (int) sizeof(hdr);  i++ )
+         sum += ( i >= 148  &&  i < 156 ? ' ' : hdr[i] );
+
+      if ( sum != chk )
+      {
+         if ( Files )  printf( "\n" );
+         printf( "  bad tar header in archive: \"%s\"\n", ArchName );
+
+         err = 1;
+         break;
+      }
+
+      size = tar_num( &hdr[124], 12 );
+
+      /* the member path: GNU long name, pax path, or ustar prefix/name */
+
+      if ( next[0] )
+      {
+         strcpy( path, next );
+         next[0] = '\0';
+      }
+      else if ( !memcmp( &hdr[257], "ustar", 5 )  &&  hdr[345] )
+      {
+         snprintf( path, sizeof(path), "%.155s/%.100s", &hdr[345], hdr );
+      }
+      else
+      {
+         snprintf( path, sizeof(path), "%.100s", hdr );
+      }
+
+      tm.left = size;
+
+      if ( hdr[156] == 'L'  ||  hdr[156] == 'x' )    /* next member's name */
+      {
+         char  ext[8192];
+
+         n = ( size < (int) sizeof(ext) - 1 ? size : (int) sizeof(ext) - 1 );
+         n = tar_read( &tm, (unsigned char*) ext, n );
+         ext[ n > 0 ? n : 0 ] = '\0';
+
+         if ( hdr[156] == 'L' )
+         {
+            snprintf( next, sizeof(next), "%s", ext );
+         }
+         else    /* pax records: "len key=value\n" */
+         {
+            for ( rec = ext;  rec < &ext[n];  rec = end )
+            {
+               end = rec + strtol( rec, NULL, 10 );
+               if ( end <= rec  ||  end > &ext[n] )  break;
+
+               if ( ( rec = strchr( rec, ' ' ) )  &&
+                    !strncmp( rec, " path=", 6 ) )
+               {
+                  snprintf( next, sizeof(next), "%.*s",
+                            (int) ( end - rec - 7 ), &rec[6] );
+               }
+            }
+         }
+      }
+      else if ( ( hdr[156] == '0'  ||  hdr[156] == '\0'  ||
+                  hdr[156] == '7' )  &&  arch_want( path ) )
+      {
+         err = arch_member( path, tar_read, &tm );
+      }
+
+      /* skip what's left of the member data, and its padding */
+
+      if ( tm.left + ( ( 512 - size % 512 ) % 512 ) > 0  &&
+           gzseek( tm.gz, tm.left + ( 512 - size % 512 ) % 512,
+                   SEEK_CUR ) < 0 )  break;
+   }
+
+   gzclose( tm.gz );
+
+   return ( err );
+}
+
+
+/* zip: members are found through the central directory (no scanning) */
+
+struct zipm    /* zip member being read */
+{
+   struct span    sp;      /* the compressed bytes */
+   int            eof;
+   z_stream       zs;      /* (deflated members) */
+   unsigned char  *in;
+};
+
+
+int  zip_deflated( void* src, unsigned char* buf, int size )
+{
+   struct zipm  *zm = src;
+   int          n, rc;
+
+   zm->zs.next_out = buf;
+   zm->zs.avail_out = size;
+
+   while ( !zm->eof  &&  zm->zs.avail_out == (uInt) size )
+   {
+      if ( !zm->zs.avail_in  &&  zm->sp.left > 0 )    /* refill the input */
+      {
+         if ( ( n = read_span( &zm->sp, zm->in, ArchBuf ) ) <= 0 )  break;
+
+         zm->zs.next_in = zm->in;
+         zm->zs.avail_in = n;
+      }
+
+      rc = inflate( &zm->zs, Z_NO_FLUSH );
+
+      if ( rc == Z_STREAM_END )  zm->eof = 1;
+      else if ( rc != Z_OK )  break;
+   }
+
+   return ( size - zm->zs.avail_out );
+}
+
+
+unsigned int  le16( unsigned char* p )
+{
+   return ( p[0] | ( p[1] << 8 ) );
+}
+
+
+unsigned int  le32( unsigned char* p )
+{
+   return ( le16( p ) | ( (unsigned int) le16( &p[2] ) << 16 ) );
+}
+
+
+unsigned long long  le64( unsigned char* p )
+{
+   return ( le32( p ) | ( (unsigned long long) le32( &p[4] ) << 32 ) );
+}
+
+
+int  arch_zip( int fd )
+{
+   unsigned char  tail[65536 + 22], loc[30], *cd = NULL, *ce, *ex;
+
+   struct zipm  zm;
+
+   char       path[4096];
+   long long  size, end, cdo, cds, ent, lho, csz;
+   int        err = 0, i, n, meth, nl, xl, cl;
+
+   /* find the end-of-central-directory record (followed by a comment) */
+
+   size = lseek( fd, 0, SEEK_END );
+   end = ( size > (int) sizeof(tail) ? size - (int) sizeof(tail) : 0 );
+
+   n = pread( fd, tail, size - end, end );
+
+   for ( i = n - 22;  i >= 0  &&  le32( &tail[i] ) != 0x06054b50;  i-- );
+
+   if ( i < 0 )
+   {
+      if ( Files )  printf( "\n" );
+      printf( "  no zip central directory in archive: \"%s\"\n", ArchName );
+
+      return ( 1 );
+   }
+
+   ent = le16( &tail[i+10] );
+   cds = le32( &tail[i+12] );
+   cdo = le32( &tail[i+16] );
+
+   /* zip64: the locator just before the record points at the real one */
+
+   if ( ( ent == 0xFFFF  ||  cds == 0xFFFFFFFF  ||  cdo == 0xFFFFFFFF )  &&
+        i >= 20  &&  le32( &tail[i-20] ) == 0x07064b50 )
+   {
+      unsigned char  z64[56];
+
+      if ( pread( fd, z64, sizeof(z64), le64( &tail[i-12] ) ) == sizeof(z64)
+           &&  le32( z64 ) == 0x06064b50 )
+      {
+         ent = le64( &z64[32] );
+         cds = le64( &z64[40] );
+         cdo = le64( &z64[48] );
+      }
+   }
+
+   if ( !( cd = malloc( cds + 1 ) )  ||
+        pread( fd, cd, cds, cdo ) != cds )
+   {
+      if ( Files )  printf( "\n" );
+      printf( "  bad zip central directory in archive: \"%s\"\n", ArchName );
+
+      if ( cd )  free( cd );
+      return ( 1 );
+   }
+
+   memset( &zm, 0x00, sizeof(zm) );
+
+   zm.sp.fd = fd;
+
+   for ( ce = cd;  !err  &&  ent > 0  &&  ce + 46 <= cd + cds;
+         ent--, ce += 46 + nl + xl + cl )
+   {
+      if ( le32( ce ) != 0x02014b50 )  break;
+
+      meth = le16( &ce[10] );
+      csz  = le32( &ce[20] );
+      nl   = le16( &ce[28] );
+      xl   = le16( &ce[30] );
+      cl   = le16( &ce[32] );
+      lho  = le32( &ce[42] );
+
+      if ( ce + 46 + nl + xl + cl > cd + cds )    /* (runs off the end) */
+      {
+         if ( Files )  printf( "\n" );
+         printf( "  bad zip central directory in archive: \"%s\"\n",
+                 ArchName );
+
+         err = 1;
+         break;
+      }
+
+      snprintf( path, sizeof(path), "%.*s", nl, &ce[46] );
+
+      /* zip64 extra field: the 64-bit sizes and offset (only those needed, */
+      /* and only those inside the field's record) */
+
+      for ( ex = &ce[46+nl];  ex + 4 <= &ce[46+nl+xl]  &&
+            ex + 4 + le16( &ex[2] ) <= &ce[46+nl+xl];  ex += 4 + le16( &ex[2] ) )
+      {
+         if ( le16( ex ) == 0x0001 )
+         {
+            unsigned char  *zp = &ex[4], *ze = &ex[ 4 + le16( &ex[2] ) ];
+
+            if ( le32( &ce[24] ) == 0xFFFFFFFF )  zp += 8;
+
+            if ( csz == 0xFFFFFFFF  &&  zp + 8 <= ze )
+            {
+               csz = le64( zp );
+               zp += 8;
+            }
+
+            if ( lho == 0xFFFFFFFF  &&  zp + 8 <= ze )  lho = le64( zp );
+         }
+      }
+
+      if ( !nl  ||  path[nl-1] == '/'  ||  !arch_want( path ) )  continue;
+
+      if ( le16( &ce[8] ) & 1  ||  ( meth != 0  &&  meth != 8 ) )
+      {
+         if ( Files )  printf( "\n" );
+         if ( le16( &ce[8] ) & 1 )
+            printf( "  skipped encrypted member: \"%s\"\n", path );
+         else
+            printf( "  skipped member: \"%s\" (compression method %i)\n",
+                    path, meth );
+         continue;
+      }
+
+      /* go straight to the member's data via its local header */
+
+      if ( pread( fd, loc, sizeof(loc), lho ) != sizeof(loc)  ||
+           le32( loc ) != 0x04034b50 )
+      {
+         if ( Files )  printf( "\n" );
+         printf( "  bad local header for member: \"%s\"\n", path );
+         continue;
+      }
+
+      zm.sp.pos = lho + 30 + le16( &loc[26] ) + le16( &loc[28] );
+      zm.sp.left = csz;
+      zm.eof = 0;
+
+      if ( meth == 0 )    /* stored */
+      {
+         err = arch_member( path, read_span, &zm.sp );
+      }
+      else    /* deflated (raw deflate stream) */
+      {
+         memset( &zm.zs, 0x00, sizeof(zm.zs) );
+
+         if ( ( !zm.in  &&  !( zm.in = malloc( ArchBuf ) ) )  ||
+              inflateInit2( &zm.zs, -MAX_WBITS ) != Z_OK )
+         {
+            printf( "  error %i allocating inflate buffers\n", ENOMEM );
+            printf( "  (%s)\n", strerror( ENOMEM ) );
+
+            err = ENOMEM;
+            break;
+         }
+
+         err = arch_member( path, zip_deflated, &zm );
+
+         inflateEnd( &zm.zs );
+      }
+   }
+
+   if ( zm.in )  free( zm.in );
+   free( cd );
+
+   return ( err );
+}
+
+
+/* dump_elf - dump the selected sections or segments of an ELF file */
+
+long long  dump_elf( FILE* fpi, FILE* fpo )
+{
+   unsigned char  eh[64], ph[64], sh[64], *strs = NULL;
+
+   char       *what, nm[64], sel[1024], *tok;
+   long long  phoff, shoff, off, len, size, vad, msz, lo, hi, n, total = 0;
+   int        fd, i, ld, ok, phnum, phsz, shnum, shsz, shstr, type, segs = 0;
+   int        full = 0;
+
+   if ( !fpi  ||  !fpo )  return ( 0 );
+
+   ElfHits = 0;
+
+   fd = fileno( fpi );
+
+   if ( pread( fd, eh, sizeof(eh), 0 ) < 52  ||  memcmp( eh, "\177ELF", 4 )  ||
+        ( eh[4] != 1  &&  eh[4] != 2 )  ||  ( eh[5] != 1  &&  eh[5] != 2 ) )
+   {
+      printf( "  not an ELF file: \"%s\"\n", Name );
+      return ( 0 );
+   }
+
+   ElfW = ( eh[4] == 2 );    /* ELFCLASS64 */
+   ElfB = ( eh[5] == 2 );    /* ELFDATA2MSB */
+
+   phoff = elf_num( &eh[ ElfW ? 32 : 28 ], ElfW ? 8 : 4 );
+   shoff = elf_num( &eh[ ElfW ? 40 : 32 ], ElfW ? 8 : 4 );
+   phsz  = elf_num( &eh[ ElfW ? 54 : 42 ], 2 );
+   phnum = elf_num( &eh[ ElfW ? 56 : 44 ], 2 );
+   shsz  = elf_num( &eh[ ElfW ? 58 : 46 ], 2 );
+   shnum = elf_num( &eh[ ElfW ? 60 : 48 ], 2 );
+   shstr = elf_num( &eh[ ElfW ? 62 : 50 ], 2 );
+
+   if ( phsz > (int) sizeof(ph) )  phsz = sizeof(ph);
+   if ( shsz > (int) sizeof(sh) )  shsz = sizeof(sh);
+
+   /* sections: by name, through the section-name string table */
+
+   if ( Elf == 1  &&  shoff  &&  shsz >= ( ElfW ? 64 : 40 ) )
+   {
+      /* (extended numbering keeps the real counts in section 0) */
+
+      if ( pread( fd, sh, shsz, shoff ) == shsz )
+      {
+         if ( !shnum )  shnum = elf_num( &sh[ ElfW ? 32 : 20 ], ElfW ? 8 : 4 );
+         if ( shstr == 0xFFFF )  shstr = elf_num( &sh[ ElfW ? 40 : 24 ], 4 );
+      }
+
+      if ( pread( fd, sh, shsz, shoff + (long long) shstr * shsz ) == shsz )
+      {
+         off  = elf_num( &sh[ ElfW ? 24 : 16 ], ElfW ? 8 : 4 );
+         size = elf_num( &sh[ ElfW ? 32 : 20 ], ElfW ? 8 : 4 );
+
+         if ( ( strs = malloc( size + 1 ) )  &&
+              pread( fd, strs, size, off ) == size )
+         {
+            strs[size] = '\0';
+         }
+         else if ( strs )
+         {
+            free( strs );
+            strs = NULL;
+         }
+      }
+
+      for ( i = 1;  strs  &&  !full  &&  i < shnum;  i++ )
+      {
+         if ( pread( fd, sh, shsz, shoff + (long long) i * shsz ) != shsz )
+            break;
+
+         what = (char*) &strs[ elf_num( sh, 4 ) % ( size + 1 ) ];
+         type = elf_num( &sh[4], 4 );
+         vad  = elf_num( &sh[ ElfW ? 16 : 12 ], ElfW ? 8 : 4 );
+         off  = elf_num( &sh[ ElfW ? 24 : 16 ], ElfW ? 8 : 4 );
+         len  = elf_num( &sh[ ElfW ? 32 : 20 ], ElfW ? 8 : 4 );
+
+         if ( !what[0]  ||  !elf_want( what ) )  continue;
+
+         if ( Header )
+            fprintf( fpo, "    Section: %s   offset %llx-%llx   vaddr %llx\n",
+                     what, off, off + len, vad );
+
+         if ( type == 8 )    /* SHT_NOBITS (.bss): nothing in the file */
+         {
+            if ( Header )  fprintf( fpo, "    (no file data for section)\n" );
+            continue;
+         }
+
+         n = elf_span( fpo, fd, off, len, ( ElfVad ? vad : off ), total );
+
+         total += ( n < 0 ? -n : n );
+         full = ( n < 0 );    /* (-#: the limit is across the selection) */
+      }
+
+      if ( !strs )  printf( "  no section names in ELF file: \"%s\"\n", Name );
+   }
+
+   /* segments: PT_LOAD by number, or by virtual address range */
+
+   for ( i = 0, ld = 0;  Elf  &&  !full  &&  i < phnum;  i++ )
+   {
+      if ( pread( fd, ph, phsz, phoff + (long long) i * phsz ) != phsz )  break;
+
+      if ( elf_num( ph, 4 ) != 1 )  continue;    /* PT_LOAD only */
+
+      off  = elf_num( &ph[ ElfW ?  8 :  4 ], ElfW ? 8 : 4 );
+      vad  = elf_num( &ph[ ElfW ? 16 :  8 ], ElfW ? 8 : 4 );
+      size = elf_num( &ph[ ElfW ? 32 : 16 ], ElfW ? 8 : 4 );
+      msz  = elf_num( &ph[ ElfW ? 40 : 20 ], ElfW ? 8 : 4 );
+
+      sprintf( nm, "load%i", ld++ );
+
+      if ( Elf == 1 )    /* -s:load or -s:load# */
+      {
+         ok = elf_want( nm );
+         lo = vad;
+         hi = vad + size;
+      }
+      else    /* -s=lo-hi: the part of the segment's file data in range */
+      {
+         ok = ( ElfLo < vad + msz  &&  ElfHi > vad );
+         lo = ( ElfLo > vad ? ElfLo : vad );
+         hi = ( ElfHi < vad + size ? ElfHi : vad + size );
+      }
+
+      if ( !ok )  continue;
+
+      segs++;
+
+      if ( Header )
+         fprintf( fpo, "    Segment: %s   offset %llx-%llx   vaddr %llx-%llx\n",
+                  nm, off, off + size, vad, vad + msz );
+
+      if ( hi > lo )
+      {
+         n = elf_span( fpo, fd, off + lo - vad, hi - lo,
+                       ( ElfVad ? lo : off + lo - vad ), total );
+
+         total += ( n < 0 ? -n : n );
+         full = ( n < 0 );
+      }
+
+      if ( Header  &&  ( Elf == 1 ? msz > size : ElfHi > vad + size ) )
+         fprintf( fpo, "    (no file data past vaddr %llx)\n", vad + size );
+   }
+
+   if ( strs )  free( strs );
+
+   /* report the selections that matched nothing (like -ar's members) */
+
+   if ( Elf == 1 )
+   {
+      strncpy( sel, ElfSel, sizeof(sel) - 1 );
+      sel[ sizeof(sel) - 1 ] = '\0';
+
+      for ( i = 0, tok = strtok( sel, "," );  tok;
+            i++, tok = strtok( NULL, "," ) )
+         if ( i < 64  &&  !( ElfHits >> i & 1 ) )
+            printf( "  no section or segment \"%s\" in ELF file: \"%s\"\n",
+                    tok, Name );
+   }
+   else if ( Elf == 2  &&  !segs )
+   {
+      printf( "  no segment at vaddr %llx-%llx in ELF file: \"%s\"\n",
+              ElfLo, ElfHi, Name );
+   }
+
+   return ( full ? -total : total );    /* (-: ended at the -# limit) */
+}
+
+
+/* elf_span - dump part of the file: +# applies within it, and -# to the */
+/* whole selection (done bytes are dumped already); -: at the limit     */
+
+long long  elf_span( FILE* fpo, int fd, long long off, long long size,
+                     long long adr, long long done )
+{
+   struct span  sp;
+   long long    cnt, lim = Count;
+
+   sp.fd = fd;
+   sp.pos = off + ( Start < size ? Start : size );
+   sp.left = size - ( Start < size ? Start : size );
+
+   if ( Count )  Count -= done;
+
+   cnt = dump_src( fpo, read_span, &sp, 0, adr + sp.pos - off );
+
+   Count = lim;
+
+   return ( cnt );
+}
+
+
+/* elf_num - an ELF header field, in the file's byte order */
+
+long long  elf_num( unsigned char* p, int len )
+{
+   long long  val = 0;
+   int        i;
+
+   for ( i = 0;  i < len;  i++ )
+      val |= (long long) p[ ElfB ? len - 1 - i : i ] << ( i * 8 );
+
+   return ( val );
+}
+
+
+/* elf_want - check a section (or "load#" segment) name against -s */
+/*   (noting in ElfHits each selection that matched)                */
+
+int  elf_want( char* name )
+{
+   char  sel[1024], *tok;
+   int   i, ok = 0;
+
+   strncpy( sel, ElfSel, sizeof(sel) - 1 );
+   sel[ sizeof(sel) - 1 ] = '\0';
+
+   for ( i = 0, tok = strtok( sel, "," );  tok;
+         i++, tok = strtok( NULL, "," ) )
+   {
+      if ( ( !strcmp( tok, "load" )  &&  !strncmp( name, "load", 4 ) )  ||
+           !fnmatch( tok, name, 0 ) )
+      {
+         if ( i < 64 )  ElfHits |= 1ULL << i;
+         ok = 1;
+      }
+   }
+
+   return ( ok );
+}
+
+
+/* dump_proc - dump the selected memory regions of a live process */
+/*   (fpi is the process's /proc/<pid>/maps file; -# limits the     */
+/*   bytes dumped, and +# doesn't apply: select a lo-hi range)     */
+
+long long  dump_proc( FILE* fpi, FILE* fpo )
+{
+   static unsigned char  buf[ProcBuf];
+   static struct iovec   rv[ProcIov];
+
+   struct iovec  lv;
+   struct dmps   ds;
+
+   char       ln[1024], perm[8], *map;
+   long long  lo, hi, adr, end, at = 0, pg, cnt = 0;
+   int        i, n, nv, ok = 1;
+
+   if ( !fpi  ||  !fpo )  return ( 0 );
+
+   if ( dump_open( &ds, 0 ) )  return ( 0 );
+
+   pg = sysconf( _SC_PAGESIZE );
+
+   ProcSelHits = 0;
+
+   while ( ok  &&  fgets( ln, sizeof(ln), fpi ) )
+   {
+      /* lo-hi perm offset dev inode [path] */
+
+      n = 0;
+
+      if ( sscanf( ln, "%llx-%llx %7s %*s %*s %*s %n",
+                   &lo, &hi, perm, &n ) < 3  ||  !n )  continue;
+
+      map = &ln[n];
+      map[ strcspn( map, "\n" ) ] = '\0';
+
+      if ( !proc_sel( map, &lo, &hi ) )  continue;    /* not selected */
+
+      if ( Header )
+         fprintf( fpo, "    Region: %llx-%llx %s %s\n",
+                  lo, hi, perm, ( map[0] ? map : "(anonymous)" ) );
+
+      ds.adr = lo;
+
+      if ( perm[0] != 'r' )
+      {
+         dump_gap( fpo, &ds, hi - lo, "not readable" );
+         dump_end( fpo, &ds );
+         continue;
+      }
+
+      /* read the region in large batches of whole pages */
+
+      for ( adr = lo;  adr < hi;  )
+      {
+         end = ( hi - adr < ProcBuf ? hi : adr + ProcBuf );
+
+         for ( nv = 0, at = adr;  at < end;  nv++ )
+         {
+            rv[nv].iov_base = (void*) at;
+            rv[nv].iov_len = ( ( at / pg + 1 ) * pg < end ?
+                               ( at / pg + 1 ) * pg : end ) - at;
+            at += rv[nv].iov_len;
+         }
+
+         lv.iov_base = buf;
+         lv.iov_len = end - adr;
+
+         n = process_vm_readv( Proc, &lv, 1, rv, nv, 0 );
+
+         if ( n < 0  &&  ( errno == EPERM  ||  errno == ESRCH ) )
+         {
+            i = errno;
+
+            dump_end( fpo, &ds );
+
+            fprintf( fpo, "    error %i reading process %i memory\n", i, Proc );
+            fprintf( fpo, "    (%s)\n", strerror( i ) );
+
+            ok = 0;
+            break;
+         }
+
+         if ( n <= 0 )    /* the first page in the batch is unreadable */
+         {
+            dump_gap( fpo, &ds, rv[0].iov_len, "unreadable" );
+
+            adr += rv[0].iov_len;
+            continue;
+         }
+
+         if ( Count  &&  n > Count - cnt )  n = Count - cnt;
+
+         dump_bytes( fpo, &ds, buf, n );
+
+         cnt += n;    /* (only the bytes read: not the gaps) */
+         adr += n;
+
+         if ( Count  &&  cnt >= Count )
+         {
+            ok = 0;
+            break;
+         }
+      }
+
+      dump_end( fpo, &ds );
+   }
+
+   dump_close( &ds );
+
+   /* report the selections that matched nothing (as -s and -ar do) */
+
+   if ( ok  &&  ProcSel  &&  ProcSel[0] )
+   {
+      strncpy( ln, ProcSel, sizeof(ln) - 1 );
+      ln[ sizeof(ln) - 1 ] = '\0';
+
+      for ( i = 0, map = strtok( ln, "," );  map;
+            i++, map = strtok( NULL, "," ) )
+         if ( i < 64  &&  !( ProcSelHits >> i & 1 ) )
+            printf( "  no mapping \"%s\" in process %i\n", map, Proc );
+   }
+
+   return ( Count  &&  cnt >= Count ? -cnt : cnt );    /* (-: at the limit) */
+}
+
+
+/* proc_sel - check a mapping against the -pid selections (trims lo/hi) */
+
+int  proc_sel( char* map, long long* lo, long long* hi )
+{
+   char       sel[256], *tok, *end;
+   long long  slo, shi, mlo = *lo, mhi = *hi;
+   int        i, ok = 0;
+
+   if ( !ProcSel  ||  !ProcSel[0] )  return ( 1 );    /* everything */
+
+   strncpy( sel, ProcSel, sizeof(sel) - 1 );
+   sel[ sizeof(sel) - 1 ] = '\0';
+
+   /* (the first selection that matches trims the region; every one that */
+   /* matches is noted in ProcSelHits) */
+
+   for ( i = 0, tok = strtok( sel, "," );  tok;
+         i++, tok = strtok( NULL, "," ) )
+   {
+      slo = strtoll( tok, &end, 16 );
+
+      if ( end != tok  &&  *end == '-' )    /* lo-hi address range */
+      {
+         shi = strtoll( &end[1], &end, 16 );
+
+         if ( *end  ||  slo >= mhi  ||  shi <= mlo )  continue;
+
+         if ( !ok )
+         {
+            if ( slo > *lo )  *lo = slo;
+            if ( shi < *hi )  *hi = shi;
+         }
+      }
+      else if ( !map[0]  ||  !strstr( map, tok ) )    /* mapping name */
+      {
+         continue;
+      }
+
+      if ( i < 64 )  ProcSelHits |= 1ULL << i;
+      ok = 1;
+   }
+
+   return ( ok );
+}
+
+
+/* dump_mux - dump several streams (FIFOs, devices) as their bytes arrive */
+
+int  dump_mux()
+{
+   static unsigned char  buf[DumpBuf];
+
+   struct epoll_event  ev, evs[MuxMax];
+   struct sigaction    sa, old;
+   struct muxs         *ms, *m;
+   struct stat         sts;
+
+   long long  total = 0, k;
+   int        ep, err = 0, i, live = 0, n, w = 0, out = 0, lim = !!Count;
+
+   if ( !( ms = calloc( MuxN, sizeof(*ms) ) ) )
+   {
+      printf( "  error %i allocating stream buffers\n", ENOMEM );
+      printf( "  (%s)\n", strerror( ENOMEM ) );
+
+      MuxN = 0;
+      return ( ENOMEM );
+   }
+
+   if ( ( ep = epoll_create1( EPOLL_CLOEXEC ) ) < 0 )
+   {
+      err = errno;
+
+      printf( "  error %i creating the stream poll set\n", err );
+      printf( "  (%s)\n", strerror( err ) );
+   }
+
+   /* open every stream (without waiting for writers) and add it to the set */
+
+   for ( i = 0;  i < MuxN;  i++ )
+   {
+      ms[i].fd = -1;
+
+      n = strlen( MuxName[i] );
+      if ( n > w )  w = n;
+   }
+
+   if ( w > MuxTag )  w = MuxTag;
+
+   for ( i = 0;  i < MuxN  &&  !err;  i++ )
+   {
+      m = &ms[i];
+
+      m->fd = open( MuxName[i], O_RDONLY | O_NONBLOCK | O_NOCTTY );
+
+      if ( m->fd < 0 )
+      {
+         err = errno;
+
+         printf( "  error %i opening input stream: \"%s\"\n", err, MuxName[i] );
+         printf( "  (%s)\n", strerror( err ) );
+         break;
+      }
+
+      /* (epoll can only wait on streams: files are always "ready") */
+
+      if ( fstat( m->fd, &sts )  ||  !( S_ISFIFO( sts.st_mode )  ||
+           S_ISSOCK( sts.st_mode )  ||  S_ISCHR( sts.st_mode ) ) )
+      {
+         printf( "  not a FIFO, socket or device: \"%s\"\n", MuxName[i] );
+
+         err = EPERM;
+      }
+      else
+      {
+         ev.events = EPOLLIN;
+         ev.data.u32 = i;
+
+         if ( epoll_ctl( ep, EPOLL_CTL_ADD, m->fd, &ev ) < 0 )
+         {
+            err = errno;
+
+            printf( "  error %i polling input stream: \"%s\"\n", err,
+                    MuxName[i] );
+            printf( "  (%s)\n", strerror( err ) );
+         }
+      }
+
+      if ( err )
+      {
+         close( m->fd );
+         m->fd = -1;
+         break;
+      }
+
+      if ( dump_open( &m->ds, Start ) )
+      {
+         err = ENOMEM;
+         break;
+      }
+
+      m->skip = Start;
+      m->tln = snprintf( m->tag, sizeof(m->tag), "%-*.*s  ",
+                         w, w, MuxName[i] );
+
+      live++;
+   }
+
+   /* write the header (and open the output) as for a single input */
+
+   Name = DefMux;
+
+   if ( !err )  err = open_files();
+
+   if ( !err )
+   {
+      out = 1;
+
+      if ( TermFmt )  printf( "\n" );
+
+      dump_header();
+
+      for ( i = 0;  Header  &&  i < MuxN;  i++ )
+         fprintf( Fpo, "    Stream: %s\n", MuxName[i] );
+
+      /* ^C ends the capture cleanly (epoll_wait returns EINTR) */
+
+      MuxStop = 0;
+
+      memset( &sa, 0x00, sizeof(sa) );
+      sa.sa_handler = mux_stop;
+      sigaction( SIGINT, &sa, &old );
+   }
+
+   /* wait on all streams; dump whatever has arrived on each ready one */
+
+   while ( !err  &&  live  &&  !MuxStop )
+   {
+      k = ( FlushOut ? FlushMs : -1 );    /* (+u#: wake up to flush) */
+
+      if ( ( n = epoll_wait( ep, evs, MuxMax, k ) ) < 0 )
+      {
+         if ( errno == EINTR )  continue;
+
+         err = errno;
+         break;
+      }
+
+      if ( !n  &&  FlushOut )    /* (+u#) all streams idle: flush */
+      {
+         fflush( FlushOut );
+         FlushOut = NULL;
+      }
+
+      for ( i = 0;  i < n;  i++ )
+      {
+         m = &ms[ evs[i].data.u32 ];
+
+         if ( m->fd < 0 )  continue;
+
+         if ( ( k = read( m->fd, buf, sizeof(buf) ) ) < 0  &&
+              ( errno == EAGAIN  ||  errno == EINTR ) )  continue;
+
+         LineTag = m->tag;
+         LineTagN = m->tln;
+
+         if ( k > 0 )
+         {
+            k = mux_put( Fpo, m, buf, k );
+         }
+
+         if ( k <= 0 )    /* end of stream (or count limit, or error) */
+         {
+            mux_end( Fpo, m );
+            live--;
+         }
+      }
+   }
+
+   /* finish off any streams that are still open, and report */
+
+   for ( i = 0;  i < MuxN;  i++ )
+   {
+      m = &ms[i];
+
+      LineTag = m->tag;
+      LineTagN = m->tln;
+
+      if ( m->fd >= 0  &&  out )  mux_end( Fpo, m );
+      if ( m->fd >= 0 )  close( m->fd );
+
+      total += m->ds.cnt;
+      lim = ( lim  &&  m->ds.cnt >= Count );    /* all stopped at the limit */
+
+      dump_close( &m->ds );
+   }
+
+   LineTag = NULL;
+   LineTagN = 0;
+
+   if ( out )
+   {
+      sigaction( SIGINT, &old, NULL );
+
+      if ( err )  fprintf( Fpo, "  error %i reading streams (%s)\n",
+                           err, strerror( err ) );
+
+      dump_footer( lim ? -total : total );
+      Files++;
+   }
+
+   if ( ep >= 0 )  close( ep );
+
+   free( ms );
+
+   MuxN = 0;
+   Name = NULL;
+
+   return ( err );
+}
+
+
+/* mux_put - dump bytes read from a stream (0: the stream is done) */
+
+long long  mux_put( FILE* fpo, struct muxs* m, unsigned char* buf, long long n )
+{
+   long long  k = 0;
+
+   if ( m->skip )    /* still reading up to the start byte */
+   {
+      k = ( m->skip < n ? m->skip : n );
+      m->skip -= k;
+   }
+
+   if ( Count  &&  n - k > Count - m->ds.cnt )  n = k + Count - m->ds.cnt;
+
+   dump_bytes( fpo, &m->ds, &buf[k], n - k );
+
+   return ( Count  &&  m->ds.cnt >= Count ? 0 : n );
+}
+
+
+/* mux_end - finish a stream's last line and drop it from the poll set */
+
+void  mux_end( FILE* fpo, struct muxs* m )
+{
+   dump_end( fpo, &m->ds );
+
+   if ( Footer )
+      fprintf( fpo, "%s(end of stream: %lli byte%s)\n",
+               m->tag, m->ds.cnt, ss( m->ds.cnt == 1 ) );
+
+   close( m->fd );    /* (also removes it from the epoll set) */
+   m->fd = -1;
+
+   return;
+}
+
+
+void  mux_stop( int sig )
+{
+   (void) sig;
+
+   MuxStop = 1;
+
+   return;
+}
+
+
+/* dump_watch - dump each file completed in a directory (on a worker pool) */
+
+int  dump_watch( char* dir )
+{
+   static char  ev[WatchEvt] __attribute__(( aligned(8) ));
+
+   struct inotify_event  *ie;
+   struct wjob           *job;
+   struct sigaction      sa, oint, oterm, ousr, ochld;
+   struct pollfd         pf;
+   struct dirent         *de;
+
+   DIR   *dp;
+   char  *ext, *p;
+   long long  size;
+   int        err = 0, fd, i, n, st, pid, node;
+
+   if ( Pipe )
+   {
+      printf( "  invalid option: -watch is not valid in pipe operations\n" );
+      return ( 1 );
+   }
+
+   if ( AllOut )    /* (each worker would start the combined file over) */
+   {
+      printf( "  combined output (-f:/-f=) is not valid with -watch\n" );
+      return ( 1 );
+   }
+
+   if ( Jobs <= 0 )  Jobs = sysconf( _SC_NPROCESSORS_ONLN );
+   if ( Jobs <= 0 )  Jobs = 1;
+   if ( Jobs > WatchMax )  Jobs = WatchMax;
+
+   if ( !ToFile )  ToFile = 1;    /* dumps go to files (-f naming rules) */
+
+   plan_make();    /* (for files: no automatic color) */
+
+   numa_nodes();
+
+   ext = ( OutExtn[0] ? OutExtn : DefExtn );
+
+   if ( !( Work = calloc( Jobs, sizeof(*Work) ) ) )
+   {
+      printf( "  error %i allocating watch workers\n", ENOMEM );
+      printf( "  (%s)\n", strerror( ENOMEM ) );
+
+      return ( ENOMEM );
+   }
+
+   if ( ( fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC ) ) < 0  ||
+        inotify_add_watch( fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO ) < 0 )
+   {
+      err = errno;
+
+      printf( "  error %i watching directory: \"%s\"\n", err, dir );
+      printf( "  (%s)\n", strerror( err ) );
+
+      if ( fd >= 0 )  close( fd );
+      free( Work );
+
+      return ( err );
+   }
+
+   /* the files already waiting in the directory go first */
+
+   if ( ( dp = opendir( dir ) ) )
+   {
+      while ( ( de = readdir( dp ) ) )
+      {
+         if ( de->d_type == DT_REG  ||  de->d_type == DT_UNKNOWN )
+            watch_add( dir, de->d_name, ext );
+      }
+
+      closedir( dp );
+   }
+
+   /* ^C/TERM stop the watch, USR1 reports stats, CHLD wakes up the poll */
+
+   WatchStop = 0;
+   WatchStat = 0;
+
+   memset( &sa, 0x00, sizeof(sa) );
+   sa.sa_handler = watch_sig;
+
+   sigaction( SIGINT, &sa, &oint );
+   sigaction( SIGTERM, &sa, &oterm );
+   sigaction( SIGUSR1, &sa, &ousr );
+   sigaction( SIGCHLD, &sa, &ochld );
+
+   if ( Header )
+      printf( "\n    Watching: %s   (%i worker%s)\n", dir, Jobs, ss( Jobs == 1 ) );
+
+   fflush( stdout );    /* (don't hand the workers our buffered output) */
+
+   while ( !WatchStop  ||  WatchRun )
+   {
+      /* collect finished workers, then start queued files on free ones */
+
+      while ( ( pid = waitpid( -1, &st, WNOHANG ) ) > 0 )
+         watch_done( pid, st );
+
+      for ( i = 0;  i < Jobs  &&  WatchHead  &&  !WatchStop;  i++ )
+      {
+         if ( Work[i].pid )  continue;
+
+         job = WatchHead;
+
+         if ( !( WatchHead = job->next ) )  WatchTail = NULL;
+         WatchQueue--;
+
+         node = watch_node( job->name, &size );
+
+         fflush( stdout );
+
+         if ( ( pid = fork() ) == 0 )    /* (the worker runs on that node) */
+         {
+            numa_bind( node );
+            _exit( watch_dump( job->name ) );
+         }
+
+         if ( pid < 0 )    /* (counted as failed; the input is left alone) */
+         {
+            printf( "  error %i starting a worker for: \"%s\"\n",
+                    errno, job->name );
+            WatchFail++;
+            free( job );
+            continue;
+         }
+
+         Work[i].pid = pid;
+         Work[i].job = job;
+         Work[i].node = node;
+         Work[i].size = size;
+         Work[i].t0 = stamp_clock();
+         WatchRun++;
+      }
+
+      if ( WatchStat )
+      {
+         watch_stats();
+         WatchStat = 0;
+      }
+
+      /* wait for new files (or a worker to finish, or a signal) */
+
+      pf.fd = fd;
+      pf.events = POLLIN;
+
+      if ( poll( &pf, 1, WatchPoll ) <= 0 )  continue;
+
+      while ( ( n = read( fd, ev, sizeof(ev) ) ) > 0 )
+      {
+         for ( p = ev;  p < &ev[n];  p += sizeof(*ie) + ie->len )
+         {
+            ie = (struct inotify_event*) p;
+
+            if ( ie->len  &&  !( ie->mask & IN_ISDIR ) )
+               watch_add( dir, ie->name, ext );
+         }
+      }
+   }
+
+   sigaction( SIGINT, &oint, NULL );
+   sigaction( SIGTERM, &oterm, NULL );
+   sigaction( SIGUSR1, &ousr, NULL );
+   sigaction( SIGCHLD, &ochld, NULL );
+
+   close( fd );
+
+   watch_stats();
+
+   /* drop the files that were still queued (they stay in the directory) */
+
+   while ( ( job = WatchHead ) )
+   {
+      WatchHead = job->next;
+      free( job );
+   }
+
+   WatchTail = NULL;
+   WatchQueue = 0;
+
+   free( Work );
+   Work = NULL;
+
+   Files++;
+
+   return ( err );
+}
+
+
+/* watch_add - queue a file for dumping (skipping hidden and dump files) */
+
+void  watch_add( char* dir, char* name, char* ext )
+{
+   struct wjob  *job;
+
+   int  n = strlen( name ), e = strlen( ext );
+
+   if ( name[0] == '.' )  return;    /* hidden (or a temp file being built) */
+
+   if ( n >= e  &&  !strcmp( &name[ n - e ], ext ) )  return;    /* output */
+
+   if ( !( job = malloc( sizeof(*job) + strlen( dir ) + n + 2 ) ) )
+   {
+      printf( "  error %i queuing file: \"%s\"\n", ENOMEM, name );
+      return;
+   }
+
+   job->next = NULL;
+   sprintf( job->name, "%s/%s", dir, name );
+
+   if ( WatchTail )
+      WatchTail->next = job;
+   else
+      WatchHead = job;
+
+   WatchTail = job;
+
+   if ( ++WatchQueue > WatchPeak )  WatchPeak = WatchQueue;
+
+   return;
+}
+
+
+/* watch_dump - dump one file (in a worker process); returns the exit code */
+
+int  watch_dump( char* path )
+{
+   long long  cnt;
+   int        err;
+
+   signal( SIGINT, SIG_DFL );
+   signal( SIGTERM, SIG_DFL );
+
+   Name = path;
+
+   if ( Arch )
+   {
+      err = dump_archive( Name );
+   }
+   else if ( !( err = open_files() ) )
+   {
+      if ( TermFmt )  printf( "\n" );
+
+      dump_header();
+
+      if ( Elf )
+         cnt = dump_elf( Fpi, Fpo );
+      else
+         cnt = dump_file( Fpi, Fpo );
+
+      dump_footer( cnt );
+   }
+
+   fflush( NULL );
+
+   return ( err ? 1 : 0 );
+}
+
+
+/* watch_done - a worker finished: retire (move or delete) its input */
+
+void  watch_done( int pid, int st )
+{
+   char  to[1024], *base;
+   int   i;
+
+   for ( i = 0;  i < Jobs  &&  Work[i].pid != pid;  i++ );
+
+   if ( i >= Jobs )  return;    /* (not one of ours) */
+
+   if ( WIFEXITED( st )  &&  !WEXITSTATUS( st ) )
+   {
+      WatchDone++;
+
+      node_stat( Work[i].node, Work[i].size, stamp_clock() - Work[i].t0 );
+
+      if ( WatchDel )    /* +done: delete it */
+      {
+         unlink( Work[i].job->name );
+      }
+      else if ( WatchTo )    /* -done=dir: move it */
+      {
+         base = strrchr( Work[i].job->name, '/' );
+
+         snprintf( to, sizeof(to), "%s%s", WatchTo, base );
+
+         if ( rename( Work[i].job->name, to ) )
+            printf( "  error %i moving \"%s\" to \"%s\"\n",
+                    errno, Work[i].job->name, WatchTo );
+      }
+   }
+   else
+   {
+      WatchFail++;
+   }
+
+   free( Work[i].job );
+
+   Work[i].pid = 0;
+   Work[i].job = NULL;
+   WatchRun--;
+
+   return;
+}
+
+
+void  watch_stats()
+{
+   int  i;
+
+   printf( "    Watch: %lli dumped, %lli failed, %i running, %i queued"
+           " (backlog peak %i)\n",
+           WatchDone, WatchFail, WatchRun, WatchQueue, WatchPeak );
+
+   for ( i = 0;  i < Nodes;  i++ )    /* throughput while busy, per node */
+   {
+      printf( "      node %i: %lli file%s, %lli bytes, %lli MB/s\n",
+              i, NodeFiles[i], ss( NodeFiles[i] == 1 ), NodeBytes[i],
+              NodeBytes[i] * 1000 / ( NodeNs[i] ? NodeNs[i] : 1 ) );
+   }
+
+   fflush( stdout );
+
+   return;
+}
+
+
+/* watch_node - pick a NUMA node for a file: where its pages are cached, */
+/* or the next node in turn */
+
+int  watch_node( char* path, long long* size )
+{
+   struct stat  sts;
+
+   int  fd, node = -1;
+
+   *size = 0;
+
+   if ( ( fd = open( path, O_RDONLY ) ) < 0 )  return ( 0 );
+
+   if ( fstat( fd, &sts ) == 0 )  *size = sts.st_size;
+
+   if ( numa_nodes() > 1  &&  *size > 0 )  node = numa_file( fd, 0 );
+
+   close( fd );
+
+   if ( node < 0 )  node = WatchRr++ % Nodes;
+
+   return ( node );
+}
+
+
+void  node_stat( int node, long long bytes, long long ns )
+{
+   NodeFiles[node]++;
+   NodeBytes[node] += bytes;
+   NodeNs[node] += ns;
+
+   return;
+}
+
+
+void  watch_sig( int sig )
+{
+   if ( sig == SIGUSR1 )
+      WatchStat = 1;
+   else if ( sig != SIGCHLD )
+      WatchStop = 1;
+
+   return;
+}
+
+
+/* numa_nodes - find the NUMA nodes and their CPUs (once); returns the count */
+
+int  numa_nodes()
+{
+   FILE  *fp;
+   char  path[64], ln[4096], *p;
+   int   i, lo, hi, n;
+
+   if ( Nodes )  return ( Nodes );
+
+   for ( i = 0;  i < NodeMax;  i++ )
+   {
+      sprintf( path, "/sys/devices/system/node/node%i/cpulist", i );
+
+      if ( !( fp = fopen( path, "r" ) ) )  break;
+
+      CPU_ZERO( &NodeCpus[i] );
+
+      if ( fgets( ln, sizeof(ln), fp ) )    /* like "0-7,16-23" */
+      {
+         for ( p = ln;  sscanf( p, "%d%n", &lo, &n ) == 1;  )
+         {
+            p += n;
+            hi = lo;
+
+            if ( *p == '-'  &&  sscanf( &p[1], "%d%n", &hi, &n ) == 1 )
+               p += n + 1;
+
+            for ( ;  lo <= hi  &&  lo < CPU_SETSIZE;  lo++ )
+               CPU_SET( lo, &NodeCpus[i] );
+
+            if ( *p == ',' )  p++;
+         }
+      }
+
+      fclose( fp );
+   }
+
+   Nodes = ( i ? i : 1 );    /* (no sysfs nodes: one node, all CPUs) */
+
+   if ( !i )  sched_getaffinity( 0, sizeof(NodeCpus[0]), &NodeCpus[0] );
+
+   if ( Debug )  printf( "(NUMA nodes: %i)\n", Nodes );
+
+   return ( Nodes );
+}
+
+
+/* numa_here - the node of the CPU this thread is running on */
+
+int  numa_here()
+{
+   unsigned int  cpu = 0, node = 0;
+
+   if ( numa_nodes() < 2  ||  syscall( SYS_getcpu, &cpu, &node, NULL ) )
+      return ( 0 );
+
+   return ( (int) node < Nodes ? (int) node : 0 );
+}
+
+
+/* numa_where - the node holding most of a mapping's resident pages (-1: ?) */
+
+int  numa_where( void* adr, long long size )
+{
+   void  *pg[NodePages];
+   int   st[NodePages], cnt[NodeMax], i, n, best = -1;
+
+   long long  psz = sysconf( _SC_PAGESIZE );
+
+   if ( numa_nodes() < 2 )  return ( 0 );
+
+   n = ( size + psz - 1 ) / psz;
+   if ( n > NodePages )  n = NodePages;
+
+   for ( i = 0;  i < n;  i++ )  pg[i] = (char*) adr + i * psz;
+
+   memset( cnt, 0x00, sizeof(cnt) );
+
+   /* (move_pages with no target nodes just reports where each page is) */
+
+   if ( syscall( SYS_move_pages, 0, n, pg, NULL, st, 0 ) )  return ( -1 );
+
+   for ( i = 0;  i < n;  i++ )
+   {
+      if ( st[i] >= 0  &&  st[i] < Nodes )  cnt[ st[i] ]++;
+   }
+
+   for ( i = 0;  i < Nodes;  i++ )
+   {
+      if ( cnt[i]  &&  ( best < 0  ||  cnt[i] > cnt[best] ) )  best = i;
+   }
+
+   return ( best );
+}
+
+
+/* numa_bind - run this thread on a node's CPUs (so that its new memory */
+/* is first touched, and so allocated, on that node) */
+
+void  numa_bind( int node )
+{
+   if ( numa_nodes() < 2  ||  node < 0  ||  node >= Nodes )  return;
+
+   sched_setaffinity( 0, sizeof(NodeCpus[node]), &NodeCpus[node] );
+
+   return;
+}
+
+
+/* numa_file - the node caching most of a file's first pages (-1: none) */
+/*   (only the cached pages are touched, to map them in: move_pages     */
+/*   can't place a page that isn't mapped, and reading the others       */
+/*   would cache them here)                                              */
+
+int  numa_file( int fd, long long pos )
+{
+   struct stat    sts;
+   unsigned char  vec[NodePages];
+
+   long long  psz = sysconf( _SC_PAGESIZE ), len = NodePages * psz;
+   volatile unsigned char  sum = 0;
+   unsigned char  *map;
+   int        node, i;
+
+   if ( numa_nodes() < 2 )  return ( 0 );
+
+   pos -= pos % psz;
+
+   if ( fstat( fd, &sts )  ||  sts.st_size <= pos )  return ( -1 );
+   if ( sts.st_size - pos < len )  len = sts.st_size - pos;
+
+   map = mmap( NULL, len, PROT_READ, MAP_SHARED, fd, pos );
+
+   if ( map == MAP_FAILED )  return ( -1 );
+
+   if ( mincore( map, len, vec ) == 0 )
+   {
+      for ( i = 0;  i * psz < len;  i++ )
+         if ( vec[i] & 1 )  sum += map[ i * psz ];
+   }
+
+   node = numa_where( map, len );
+
+   munmap( map, len );
+
+   if ( Debug )  printf( "(input cached on NUMA node: %i)\n", node );
+
+   return ( node );
+}
+
+
+/* view_file - interactive viewer: render only the lines on the screen */
+
+int  view_file( char* name )
+{
+   struct stat  sts;
+   struct termios  raw;
+   struct sigaction  sa;
+
+   long long  max, top, adr, hit = -1;
+   int        err = 0, dir = 1, len = 0, n, rows;
+   char       key[16], ln[256], *msg = "";
+
+   unsigned char  pat[128];
+
+   if ( !isatty( STDOUT_FILENO ) )
+   {
+      printf( "  interactive view requires a terminal for output\n" );
+      return ( 1 );
+   }
+
+   if ( PerLine <= 0 )  PerLine = 16;    /* the viewer needs whole lines */
+   Color = 0;    /*   (and clips them by length: no color escapes) */
+
+   plan_make();
+
+   /* open the input and map it (or fall back to positioned reads) */
+
+   if ( ( ViewFd = open( name, O_RDONLY ) ) < 0  ||
+        fstat( ViewFd, &sts ) < 0 )
+   {
+      err = errno;
+
+      printf( "  error %i opening input file: \"%s\"\n", err, name );
+      printf( "  (%s)\n", strerror( err ) );
+
+      view_done();
+      return ( err );
+   }
+
+   ViewSize = sts.st_size;
+   ViewMap = NULL;
+
+   if ( ViewSize > 0 )
+   {
+      ViewMap = mmap( NULL, ViewSize, PROT_READ, MAP_SHARED, ViewFd, 0 );
+
+      if ( ViewMap == MAP_FAILED )  ViewMap = NULL;
+   }
+
+   if ( ( !ViewMap  ||  Plan.xn )  &&
+        !( ViewBuf = malloc( ViewBlk * Plan.per ) ) )
+   {
+      printf( "  error %i allocating view buffers\n", ENOMEM );
+      printf( "  (%s)\n", strerror( ENOMEM ) );
+
+      view_done();
+      return ( ENOMEM );
+   }
+
+   if ( Debug )  printf( "(view size: %lli  mapped: %s)\n",
+                         ViewSize, ( ViewMap ? "yes" : "no" ) );
+
+   /* take over the terminal: raw keys, alternate screen, no auto-wrap */
+
+   if ( ( ViewTty = open( "/dev/tty", O_RDWR ) ) < 0  ||
+        tcgetattr( ViewTty, &ViewTio ) < 0 )
+   {
+      err = errno;
+
+      printf( "  error %i opening terminal: \"/dev/tty\"\n", err );
+      printf( "  (%s)\n", strerror( err ) );
+
+      view_done();
+      return ( err );
+   }
+
+   raw = ViewTio;
+   raw.c_lflag &= ~( ICANON | ECHO );
+   raw.c_cc[VMIN] = 1;
+   raw.c_cc[VTIME] = 0;
+
+   tcsetattr( ViewTty, TCSAFLUSH, &raw );
+
+   memset( &sa, 0x00, sizeof(sa) );
+   sa.sa_handler = view_winch;    /* no SA_RESTART: wake up the key read */
+   sigaction( SIGWINCH, &sa, NULL );
+
+   view_put( "\033[?1049h\033[?7l\033[?25l", -1 );
+
+   view_size();
+
+   /* start at the '+#' start byte, if any */
+
+   top = Start / Plan.per;
+
+   while ( !err )
+   {
+      rows = ViewRows - 1;    /* the bottom row is the status line */
+
+      max = ( ViewSize + Plan.per - 1 ) / Plan.per - rows;
+      if ( max < 0 )  max = 0;
+
+      if ( top > max )  top = max;
+      if ( top < 0 )  top = 0;
+
+      view_draw( name, top, hit, msg );
+      msg = "";
+
+      if ( ( n = read( ViewTty, key, sizeof(key) - 1 ) ) <= 0 )
+      {
+         if ( n < 0  &&  errno == EINTR )    /* window size changed */
+         {
+            view_size();
+            continue;
+         }
+         break;
+      }
+
+      key[n] = '\0';
+
+      if ( key[0] == 'q'  ||  key[0] == 'Q' )
+         break;
+      else if ( key[0] == 'j'  ||  key[0] == '\n'  ||  key[0] == '\r'  ||
+                !strcmp( key, "\033[B" ) )
+         top++;
+      else if ( key[0] == 'k'  ||  !strcmp( key, "\033[A" ) )
+         top--;
+      else if ( key[0] == ' '  ||  key[0] == 'f'  ||  !strcmp( key, "\033[6~" ) )
+         top += rows;
+      else if ( key[0] == 'b'  ||  !strcmp( key, "\033[5~" ) )
+         top -= rows;
+      else if ( key[0] == 'g'  ||  !strcmp( key, "\033[H" ) )
+         top = 0;
+      else if ( key[0] == 'G'  ||  !strcmp( key, "\033[F" ) )
+         top = max;
+      else if ( key[0] == ':' )    /* jump to an address */
+      {
+         if ( view_ask( "address (hex): ", ln, sizeof(ln) ) > 0 )
+         {
+            char  *end;
+
+            adr = strtoll( ln, &end, 16 );
+
+            if ( *end  ||  adr < 0  ||  adr >= ViewSize )
+               msg = "(bad address)";
+            else
+               top = adr / Plan.per;
+         }
+      }
+      else if ( key[0] == '/'  ||  key[0] == '?' )    /* search */
+      {
+         dir = ( key[0] == '/' ? 1 : -1 );
+
+         if ( view_ask( ( dir > 0 ? "find: " : "find backward: " ),
+                        ln, sizeof(ln) ) > 0 )
+         {
+            if ( ( len = view_pat( ln, pat, sizeof(pat) ) ) <= 0 )
+            {
+               msg = "(bad pattern)";
+            }
+            else
+            {
+               hit = -1;
+               key[0] = 'n';    /* search right away */
+            }
+         }
+      }
+
+      if ( ( key[0] == 'n'  ||  key[0] == 'N' )  &&  len > 0 )  /* search */
+      {
+         n = ( key[0] == 'n' ? dir : -dir );
+
+         if ( hit >= 0 )
+            adr = hit + n;
+         else
+            adr = ( n > 0 ? top * Plan.per : ( top + rows ) * Plan.per - 1 );
+
+         if ( ( adr = view_find( adr, pat, len, n ) ) < 0 )
+         {
+            msg = "(pattern not found)";
+         }
+         else
+         {
+            hit = adr;
+
+            if ( hit / Plan.per < top  ||  hit / Plan.per >= top + rows )
+               top = hit / Plan.per - rows / 3;
+         }
+      }
+   }
+
+   view_done();
+
+   return ( err );
+}
+
+
+/* view_done - restore the terminal and release the input */
+
+void  view_done()
+{
+   int  i;
+
+   if ( ViewTty >= 0 )
+   {
+      view_put( "\033[?25h\033[?7h\033[?1049l", -1 );
+      view_put( NULL, 0 );
+
+      tcsetattr( ViewTty, TCSAFLUSH, &ViewTio );
+      close( ViewTty );
+   }
+
+   signal( SIGWINCH, SIG_DFL );
+
+   if ( ViewMap )  munmap( ViewMap, ViewSize );
+   if ( ViewBuf )  free( ViewBuf );
+   if ( ViewFd >= 0 )  close( ViewFd );
+
+   for ( i = 0;  i < ViewPages;  i++ )
+   {
+      if ( ViewCache[i].txt )  free( ViewCache[i].txt );
+      memset( &ViewCache[i], 0x00, sizeof(ViewCache[i]) );
+   }
+
+   ViewMap = NULL;
+   ViewBuf = NULL;
+   ViewFd = -1;
+   ViewTty = -1;
+
+   return;
+}
+
+
+void  view_winch( int sig )
+{
+   (void) sig;
+
+   return;    /* (interrupts the key read so the screen gets re-sized) */
+}
+
+
+void  view_size()
+{
+   struct winsize  ws;
+
+   ViewRows = 24;
+   ViewCols = 80;
+
+   if ( ioctl( ViewTty, TIOCGWINSZ, &ws ) == 0  &&  ws.ws_row > 1 )
+   {
+      ViewRows = ws.ws_row;
+      ViewCols = ws.ws_col;
+   }
+
+   return;
+}
+
+
+/* view_put - append to the screen frame; flush it on a NULL string */
+
+void  view_put( char* str, int len )
+{
+   static char  frame[65536];
+   static int   fn = 0;
+
+   if ( len < 0 )  len = ( str ? strlen( str ) : 0 );
+
+   if ( !str  ||  fn + len > (int) sizeof(frame) )
+   {
+      if ( fn )  write( STDOUT_FILENO, frame, fn );
+      fn = 0;
+   }
+
+   if ( !str )  return;
+
+   if ( len > (int) sizeof(frame) )
+   {
+      write( STDOUT_FILENO, str, len );
+   }
+   else
+   {
+      memcpy( &frame[fn], str, len );
+      fn += len;
+   }
+
+   return;
+}
+
+
+/* view_line - the rendered text of one dump line (via the page cache) */
+
+char*  view_line( long long line, int* len )
+{
+   struct vpage   *pg;
+   long long      page = line / ViewBlk, off;
+   unsigned char  *byt;
+   int            i, n, rd = 0, tx;
+
+   pg = &ViewCache[ page % ViewPages ];
+
+   if ( !pg->txt  ||  pg->page != page )    /* render the whole page */
+   {
+      if ( !pg->txt  &&
+           !( pg->txt = malloc( ViewBlk * Plan.line ) ) )
+      {
+         *len = 0;
+         return ( "" );
+      }
+
+      pg->page = page;
+
+      if ( !ViewMap )    /* read the whole page's bytes in one go */
+      {
+         rd = pread( ViewFd, ViewBuf, ViewBlk * Plan.per,
+                     page * ViewBlk * Plan.per );
+      }
+
+      for ( i = 0, tx = 0;  i < ViewBlk;  i++ )
+      {
+         pg->off[i] = tx;
+
+         off = ( page * ViewBlk + i ) * Plan.per;
+         n = ( ViewSize - off < Plan.per ? ViewSize - off : Plan.per );
+
+         if ( n <= 0 )  continue;
+
+         if ( ViewMap )
+         {
+            byt = &ViewMap[off];
+         }
+         else
+         {
+            byt = &ViewBuf[ i * Plan.per ];
+            if ( n > rd - i * Plan.per )  n = rd - i * Plan.per;
+            if ( n <= 0 )  continue;
+         }
+
+         if ( Plan.xn )    /* (the transformed bytes) */
+         {
+            xf_apply( &ViewBuf[ i * Plan.per ], byt, n, off );
+            byt = &ViewBuf[ i * Plan.per ];
+         }
+
+         tx += fmt_line( &pg->txt[tx], byt, n, off ) - 1;    /* no '\n' */
+      }
+
+      pg->off[i] = tx;
+   }
+
+   i = line % ViewBlk;
+
+   *len = pg->off[i+1] - pg->off[i];
+
+   return ( &pg->txt[ pg->off[i] ] );
+}
+
+
+/* view_draw - redraw the screen from line 'top' */
+
+void  view_draw( char* name, long long top, long long hit, char* msg )
+{
+   char       *txt, st[512];
+   long long  line, pct = 100;
+   int        len, r;
+
+   view_put( "\033[H", -1 );
+
+   for ( r = 0;  r < ViewRows - 1;  r++ )
+   {
+      line = top + r;
+
+      if ( line * Plan.per < ViewSize )
+      {
+         txt = view_line( line, &len );
+
+         if ( hit >= 0  &&  hit / Plan.per == line )  view_put( "\033[1m", -1 );
+
+         view_put( txt, ( len < ViewCols ? len : ViewCols ) );
+         view_put( "\033[m", -1 );
+      }
+      else
+      {
+         view_put( "~", -1 );
+      }
+
+      view_put( "\033[K\r\n", -1 );
+   }
+
+   /* the status line */
+
+   if ( ViewSize  &&  ( top + ViewRows - 1 ) * Plan.per < ViewSize )
+      pct = ( top + ViewRows - 1 ) * Plan.per * 100 / ViewSize;
+
+   len = snprintf( st, sizeof(st), " %s   %08llX / %08llX   %3lli%%   %s",
+                   name, top * Plan.per, ViewSize, pct,
+                   ( msg[0] ? msg : "(q:quit  /?:find  n/N:next  :jump)" ) );
+
+   if ( len > ViewCols )  len = ViewCols;
+
+   view_put( "\033[7m", -1 );
+   view_put( st, len );
+   view_put( "\033[K\033[m", -1 );
+   view_put( NULL, 0 );
+
+   return;
+}
+
+
+/* view_ask - read a line of input on the status line */
+
+int  view_ask( char* prompt, char* ln, int size )
+{
+   int   n = 0;
+   char  ch;
+
+   ln[0] = '\0';
+
+   for ( ;; )
+   {
+      view_put( "\033[999;1H\033[K\033[?25h", -1 );
+      view_put( prompt, -1 );
+      view_put( ln, n );
+      view_put( NULL, 0 );
+
+      if ( read( ViewTty, &ch, 1 ) != 1  ||  ch == '\033' )    /* cancel */
+      {
+         n = 0;
+         break;
+      }
+
+      if ( ch == '\n'  ||  ch == '\r' )  break;
+
+      if ( ch == '\b'  ||  ch == 0x7F )    /* backspace (cancel if empty) */
+      {
+         if ( !n )  break;
+         n--;
+      }
+      else if ( isprint( ch )  &&  n < size - 1 )
+      {
+         ln[n++] = ch;
+      }
+   }
+
+   view_put( "\033[?25l", -1 );
+
+   ln[n] = '\0';
+
+   return ( n );
+}
+
+
+/* view_pat - convert a search string (text, or "x:" + hex bytes) to bytes */
+
+int  view_pat( char* ln, unsigned char* pat, int size )
+{
+   int  n = 0, hi, lo;
+
+   if ( strncmp( ln, "x:", 2 ) )    /* plain text */
+   {
+      n = strlen( ln );
+      if ( n > size )  n = size;
+
+      memcpy( pat, ln, n );
+
+      return ( n );
+   }
+
+   for ( ln += 2;  *ln  &&  n < size;  )
+   {
+      if ( isspace( *ln ) )
+      {
+         ln++;
+         continue;
+      }
+
+      if ( !isxdigit( ln[0] )  ||  !isxdigit( ln[1] ) )  return ( -1 );
+
+      hi = ( isdigit( ln[0] ) ? ln[0] - '0' : tolower( ln[0] ) - 'a' + 10 );
+      lo = ( isdigit( ln[1] ) ? ln[1] - '0' : tolower( ln[1] ) - 'a' + 10 );
+
+      pat[n++] = ( hi << 4 ) | lo;
+      ln += 2;
+   }
+
+   return ( n );
+}
+
+
+/* view_find - find the pattern at or after (dir > 0) or before 'from' */
+
+long long  view_find( long long from, unsigned char* pat, int len, int dir )
+{
+   static unsigned char  buf[ViewSeek + 128];
 
-            fprintf( fpo, "%s|%s|", sp, asc );
-         }
+   unsigned char  *p;
+   long long      pos;
+   int            n;
 
-         fprintf( fpo, "\n" );
+   if ( from < 0  ||  from >= ViewSize  ||  len > 128 )  return ( -1 );
 
-         ix = 0;
-         memset( asc, 0x00, sizeof(asc) );
+   if ( ViewMap )    /* search the mapping directly */
+   {
+      if ( dir > 0 )
+      {
+         p = memmem( &ViewMap[from], ViewSize - from, pat, len );
+      }
+      else
+      {
+         n = ( from + len <= ViewSize ? from + len : ViewSize );
+         p = find_last( ViewMap, n, pat, len );
       }
 
-      adr++;
-      cnt++;
+      return ( p ? p - ViewMap : -1 );
    }
 
-   /* end-of-file processing */
+   /* no mapping: search in large overlapping positioned reads */
 
-   if ( Ascii  &&  ix )   /* finish off the hex dump line w/ASCII */
+   if ( dir > 0 )
    {
-      /* blank-fill the rest of the hex data portion */
-
-      while ( PerLine  &&  ix < PerLine )
+      for ( pos = from;  pos < ViewSize;  pos += ViewSeek )
       {
-         if ( HexDump )  fprintf( fpo, "  " );    /* spaces instead of digits */
+         if ( ( n = pread( ViewFd, buf, ViewSeek + len - 1, pos ) ) <= 0 )
+            break;
 
-         if ( AscWide )  asc[ix] = ' ';    /* to justify the right column */
+         if ( ( p = memmem( buf, n, pat, len ) ) )  return ( pos + p - buf );
+      }
+   }
+   else
+   {
+      for ( pos = from + 1;  pos > 0;  pos -= ViewSeek )
+      {
+         long long  at = ( pos > ViewSeek ? pos - ViewSeek : 0 );
 
-         ix++;
+         if ( ( n = pread( ViewFd, buf, pos - at + len - 1, at ) ) <= 0 )
+            break;
 
-         if ( HexDump )
-         {
-            if ( WordLen  &&  ( ix % WordLen ) == 0 )  fprintf( fpo, " " );
-            if ( HalfGap  &&  ( ix % HalfGap ) == 0 )  fprintf( fpo, " " );
-         }
+         if ( ( p = find_last( buf, n, pat, len ) ) )  return ( at + p - buf );
       }
+   }
 
-      /* blank-fill the rest of the ASCII data portion */
+   return ( -1 );
+}
 
-      memset( sp, 0x00, sizeof(sp) );
 
-      if ( HexDump )
-      {
-         strcpy( sp,"  " );
-         if ( WordLen              )  sp[1] = '\0';
-         if ( WordLen  &&  HalfGap )  sp[0] = '\0';
-      }
+/* find_last - find the last occurrence of 'pat' in 'hay' */
 
-      /* write the final part of the dump line */
+unsigned char*  find_last( unsigned char* hay, long long n,
+                           unsigned char* pat, int len )
+{
+   unsigned char  *p;
 
-      fprintf( fpo, "%s|%s|\n", sp, asc );
+   if ( len <= 0 )  return ( NULL );
 
-      memset( asc, 0x00, sizeof(asc) );
-   }
-   else if ( ix )   /* finish off the hex dump line w/o ASCII */
+   for ( n -= len - 1;  n > 0;  n = p - hay )
    {
-      fprintf( fpo, "\n" );
-   }
-
-   /* report the ending (next) address, like 'hexdump -C -v' */
+      /* memrchr scans for the first pattern byte at memory speed */
 
-   if ( EndAddr )  fprintf( fpo, "%08x\n", cnt );
+      if ( !( p = memrchr( hay, pat[0], n ) ) )  break;
 
-   /* report differently for End-of-File and count-limited dumps */
+      if ( !memcmp( p, pat, len ) )  return ( p );
+   }
 
-   return ( ( ch == EOF ? cnt : -cnt ) );
+   return ( NULL );
 }
 
 
@@ -740,6 +6341,284 @@ int  proc_args( int* aix, int argc, char** argv )
          {
             err = ver_msg( ox );    /* version: { 0 1 2 3 } */
          }
+         else if ( !strcmp( optn, "ar" )  ||    /* -ar = archive members */
+                   !strncmp( optn, "ar:", 3 ) )
+         {
+            Arch = !mx;    /* -ar on, +ar off */
+
+            ArchSel = ( optn[2] ? &optn[3] : NULL );
+
+            if ( Debug )  printf( "(Arch: %i  ArchSel: \"%s\")\n",
+                                  Arch, ( ArchSel ? ArchSel : "" ) );
+         }
+         else if ( !strcmp( optn, "mux" ) )   /* -mux = multiplexed streams */
+         {
+            Mux = !mx;    /* -mux on, +mux off */
+
+            if ( Debug )  printf( "(Mux: %i)\n", Mux );
+         }
+         else if ( !strncmp( optn, "watch:", 6 )  &&  optn[6] )   /* -watch */
+         {
+            if ( Pipe )    /* pipe operation precludes other inputs */
+            {
+               printf( "  invalid option (\"%s\"): watched input is not"
+                       " valid in pipe operations\n", argv[*aix] );
+               err = 1;
+            }
+            else    /* the directory takes the place of a filename */
+            {
+               WatchDir = &optn[6];
+               Name = WatchDir;
+
+               if ( Debug )  printf( "(WatchDir: \"%s\")\n", WatchDir );
+            }
+         }
+         else if ( !strcmp( optn, "done" )  ||    /* -done +done -done=dir */
+                   !strncmp( optn, "done=", 5 ) )
+         {
+            WatchDel = mx;
+            WatchTo = ( !mx  &&  optn[4] ? &optn[5] : NULL );
+
+            if ( Debug )  printf( "(WatchDel: %i  WatchTo: \"%s\")\n",
+                                  WatchDel, ( WatchTo ? WatchTo : "" ) );
+         }
+         else if ( !strcmp( optn, "mt" ) )   /* -mt +mt = pipelined */
+         {
+            Mt = mx;
+
+            if ( Debug )  printf( "(Mt: %i)\n", Mt );
+         }
+         else if ( !strcmp( optn, "o" ) )   /* -o = end an output spec */
+         {
+            if ( Outs >= OutMax - 1 )
+            {
+               printf( "  too many -o outputs (%i at most)\n", OutMax );
+               err = 1;
+            }
+            else    /* the options so far make one output; the next one */
+            {       /* keeps the format options, but goes to stdout */
+               out_save( &OutSpec[Outs++] );
+
+               ToFile = 0;
+               AllOut = 0;
+               NewOut = 0;
+               Fpo = NULL;
+
+               memset( OutFile, 0x00, sizeof(OutFile) );
+               memset( OutExtn, 0x00, sizeof(OutExtn) );
+               memset( OutName, 0x00, sizeof(OutName) );
+            }
+
+            if ( Debug )  printf( "(Outs: %i)\n", Outs );
+         }
+         else if ( !strcmp( optn, "view" ) )   /* interactive viewer */
+         {
+            View = 1;
+         }
+         else if ( !strncmp( optn, "pid", 3 ) )   /* -pid#[:sel] = process */
+         {
+            if ( sscanf( &optn[3], "%i", &Proc ) != 1  ||  Proc <= 0 )
+            {
+               Proc = 0;
+
+               printf( "  bad process option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+            else if ( Pipe )    /* pipe operation precludes other inputs */
+            {
+               Proc = 0;
+
+               printf( "  invalid option (\"%s\"): process input is not"
+                       " valid in pipe operations\n", argv[*aix] );
+               err = 1;
+            }
+            else    /* the process takes the place of a filename */
+            {
+               ProcSel = strchr( optn, ':' );
+               if ( ProcSel )  ProcSel++;
+
+               sprintf( ProcName, "pid%i", Proc );
+               Name = ProcName;
+
+               if ( Debug )  printf( "(Proc: %i  ProcSel: \"%s\")\n",
+                                     Proc, ( ProcSel ? ProcSel : "" ) );
+            }
+         }
+         else if ( !strcmp( optn, "xxd" )  ||  !strcmp( optn, "od" )  ||
+                   !strcmp( optn, "xxd:p" )  ||  !strcmp( optn, "xxd:i" ) )
+         {
+            Emul = ( opt == 'o' ? 'o' : optn[3] ? optn[4] : 'x' );
+
+            TermFmt = 0;    /* just the tool's output (like -X) */
+            Header  = 0;
+            Footer  = 0;
+            LoCase  = 1;
+
+            AddrNum = ( Emul == 'x'  ||  Emul == 'o' ? 2 : 0 );
+            Ascii   = ( Emul == 'x'  ||  Emul == 'o' );
+            PerLine = ( Emul == 'p' ? 30 : Emul == 'i' ? 12 : 16 );
+            HalfGap = 0;
+            WordLen = ( Emul == 'x' ? 2 : Emul == 'o' );
+            AscWide = 0;
+            EndAddr = ( Emul == 'o' );
+            Sectors = 0;
+         }
+         else if ( !strncmp( optn, "cc", 2 )  &&
+                   ( !optn[2]  ||  optn[2] == ':'  ||  optn[2] == '=' ) )
+         {
+            static char  *tys[] = { "str", "u8", "u16le", "u16be", "u32le",
+                                    "u32be", "u64le", "u64be" };
+            static int   tyw[] = { -1, 1, 2, 2, 4, 4, 8, 8 };
+
+            char  *ty = "u8", *eq = strchr( optn, '=' );    /* -cc[:t][=n] */
+            int   tn = 2;
+
+            if ( optn[2] == ':' )
+            {
+               ty = &optn[3];
+               tn = ( eq ? eq - ty : (int) strlen( ty ) );
+            }
+
+            for ( i = 0;  i < 8  &&  ( (int) strlen( tys[i] ) != tn  ||
+                                       strncmp( ty, tys[i], tn ) );  i++ )  ;
+
+            if ( i < 8 )
+            {
+               CcWord = tyw[i];
+               CcBig = ( i > 1  &&  ( i & 1 ) );    /* (the "..be" types) */
+            }
+            else
+            {
+               printf( "  bad C array option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            CcName = ( eq  &&  eq[1] ? &eq[1] : NULL );
+
+            Emul = 'c';
+
+            TermFmt = 0;    /* just the source text */
+            Header  = 0;
+            Footer  = 0;
+            LoCase  = 1;
+
+            AddrNum = 0;
+            Ascii   = 0;
+            PerLine = ( CcWord < 0 ? 64 : 16 );
+            HalfGap = 0;
+            WordLen = 0;
+            EndAddr = 0;
+            Sectors = 0;
+
+            if ( Debug )  printf( "(CcWord: %i  CcBig: %i  CcName: %s)\n",
+                                  CcWord, CcBig, ( CcName ? CcName : "-" ) );
+         }
+         else if ( !strcmp( optn, "base64" )  ||  !strcmp( optn, "base32" )  ||
+                   !strcmp( optn, "ascii85" ) )    /* encode (-) / decode (+) */
+         {
+            Enc = ( opt == 'a' ? 85 : atoi( &optn[4] ) );
+            Emul = ( mx ? 'd' : 'e' );
+
+            TermFmt = 0;    /* just the encoded text (or the bytes) */
+            Header  = 0;
+            Footer  = 0;
+
+            AddrNum = 0;
+            Ascii   = 0;
+            PerLine = ( Enc == 64 ? 57 : Enc == 32 ? 45 : 64 );
+            HalfGap = 0;
+            WordLen = 0;
+            EndAddr = 0;
+            Sectors = 0;
+         }
+         else if ( !strncmp( optn, "xor:", 4 )  ||  !strncmp( optn, "add:", 4 )
+                   ||  !strncmp( optn, "sub:", 4 )  ||  !strcmp( optn, "bitrev" )
+                   ||  !strcmp( optn, "nibswap" )  ||  !strcmp( optn, "xf" ) )
+         {
+            char  *ap = &optn[4];
+            int   v = 0;
+
+            if ( opt == 'x'  &&  optn[1] == 'o' )    /* -xor:hex (the key) */
+            {
+               for ( XfKl = 0;  isxdigit( ap[0] )  &&  isxdigit( ap[1] )  &&
+                     XfKl < XfKey;  ap += 2 )
+                  XfKeyB[ XfKl++ ] = strtol( ( char[3] ){ ap[0], ap[1], 0 },
+                                             NULL, 16 );
+
+               if ( *ap )  XfKl = 0;    /* (an odd digit, or too long) */
+            }
+            else if ( opt == 'a'  ||  opt == 's' )    /* -add:# -sub:# */
+            {
+               if ( sscanf( ap, "%i", &v ) != 1  ||  v < 0  ||  v > 255 )
+                  ap = "?";
+               else
+                  ap = "";
+
+               if ( opt == 's' )  v = 256 - v;
+            }
+            else
+            {
+               ap = "";
+            }
+
+            if ( opt == 'x'  &&  optn[1] == 'f' )    /* -xf: steps cleared */
+            {
+               XfN = 0;
+               XfKl = 0;
+            }
+            else if ( *ap  ||  ( opt == 'x'  &&  !XfKl )  ||  XfN >= XfMax )
+            {
+               printf( "  bad byte transform option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+            else
+            {
+               XfOp[XfN] = ( opt == 's' ? 'a' : opt == 'b' ? 'r' : opt );
+               XfArg[ XfN++ ] = v;
+            }
+
+            if ( Debug )  printf( "(XfN: %i  XfKl: %i)\n", XfN, XfKl );
+         }
+         else if ( !strncmp( optn, "stride", 6 )  &&
+                   ( !optn[6]  ||  optn[6] == ':' ) )    /* -stride:K:p */
+         {
+            Stride = 0;
+            StridePh = 0;
+
+            if ( optn[6]  &&  ( sscanf( &optn[7], "%i:%i", &Stride,
+                                        &StridePh ) < 1  ||  Stride < 1  ||
+                                StridePh < 0  ||  StridePh >= Stride ) )
+            {
+               Stride = 0;
+               StridePh = 0;
+
+               printf( "  bad stride option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            if ( Debug )  printf( "(Stride: %i  StridePh: %i)\n", Stride,
+                                  StridePh );
+         }
+         else if ( !strncmp( optn, "chan", 4 )  &&
+                   ( !optn[4]  ||  optn[4] == ':' ) )    /* -chan:N */
+         {
+            Chans = 0;
+
+            if ( optn[4]  &&  ( sscanf( &optn[5], "%i", &Chans ) != 1  ||
+                                Chans < 2  ||  Chans > 256 ) )
+            {
+               Chans = 0;
+
+               printf( "  bad channel option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            if ( Debug )  printf( "(Chans: %i)\n", Chans );
+         }
+         else if ( !strcmp( optn, "color" ) )   /* -color +color */
+         {
+            Color = mx;
+         }
          else if ( !strcmp( optn, "xo" ) )   /* hex-only */
          {
             AddrNum = 0;
@@ -753,7 +6632,7 @@ int  proc_args( int* aix, int argc, char** argv )
          {
             if ( mx )   /* +# = set start-byte of dump */
             {
-               if ( sscanf( optn, "%i", &Start ) != 1 )
+               if ( sscanf( optn, "%lli", &Start ) != 1 )
                {
                   Start = 0;
 
@@ -763,7 +6642,7 @@ int  proc_args( int* aix, int argc, char** argv )
             }
             else   /* -N = set dump byte limit */
             {
-               if ( sscanf( optn, "%i", &Count ) != 1 )
+               if ( sscanf( optn, "%lli", &Count ) != 1 )
                {
                   Count = 0;
 
@@ -772,11 +6651,54 @@ int  proc_args( int* aix, int argc, char** argv )
                }
             }
 
-            if ( Debug )  printf( "(Start: %i   Count: %i)\n", Start, Count );
+            if ( Debug )
+               printf( "(Start: %lli   Count: %lli)\n", Start, Count );
          }
-         else if ( opt == 'a' )   /* -a */
+         else if ( opt == 'a' )   /* -a -a:code -a=file */
          {
-            Ascii = mx;
+            static char  *codes[] = { "ascii", "utf8", "latin1", "ebcdic037",
+                                      "ebcdic500" };
+
+            for ( i = 0;  i < 5  &&  ( optn[1] != ':'  ||
+                                       strcmp( &optn[2], codes[i] ) );  i++ )  ;
+
+            if ( !optn[1] )
+            {
+               Ascii = mx;
+            }
+            else if ( i < 5 )
+            {
+               Ascii = 1;
+               TextCode = "\0ulei"[i];
+            }
+            else if ( optn[1] == '='  &&  optn[2] )    /* a 256-byte table */
+            {
+               FILE  *fpt = fopen( &optn[2], "rb" );
+
+               TextMap = malloc( 256 );
+
+               if ( !fpt  ||  fread( TextMap, 1, 256, fpt ) != 256 )
+               {
+                  printf( "  can't read a 256-byte text column table from"
+                          " \"%s\"\n", &optn[2] );
+                  err = 1;
+               }
+               else
+               {
+                  Ascii = 1;
+                  TextCode = 'f';
+               }
+
+               if ( fpt )  fclose( fpt );
+            }
+            else
+            {
+               printf( "  bad text column option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            if ( Debug )  printf( "(Ascii: %i  TextCode: %c)\n", Ascii,
+                                  ( TextCode ? TextCode : '-' ) );
          }
          else if ( opt == 'c' )   /* -c */
          {
@@ -788,6 +6710,18 @@ int  proc_args( int* aix, int argc, char** argv )
             Ascii = 0;
             AddrNum = 0;
          }
+         else if ( opt == 'd'  &&  !optn[1] )   /* -d */
+         {
+            Sectors = mx;
+         }
+         else if ( opt == 'D'  &&  !optn[1] )   /* -D */
+         {
+            Direct = mx;
+         }
+         else if ( opt == 'z'  &&  !optn[1] )   /* -z */
+         {
+            Zeros = mx;
+         }
          else if ( opt == 'e' )   /* -e */
          {
             if ( !optn[1] )   /* -e = default */
@@ -886,6 +6820,61 @@ int  proc_args( int* aix, int argc, char** argv )
             Header  = mx;    /* show header info in dump output */
             Footer  = mx;    /* show footer info in dump output */
          }
+         else if ( opt == 't' )   /* -t +t +t:abdr */
+         {
+            Stamp = mx;
+            StampFmt = 'r';
+            StampBurst = 0;
+
+            for ( i = 2;  optn[1] == ':'  &&  optn[i];  i++ )
+            {
+               if ( strchr( "adr", optn[i] ) )
+                  StampFmt = optn[i];
+               else if ( optn[i] == 'b' )
+                  StampBurst = 1;
+               else
+                  break;
+            }
+
+            if ( optn[1]  &&  ( optn[1] != ':'  ||  optn[i] ) )
+            {
+               printf( "  bad time stamp option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            if ( Debug )  printf( "(Stamp: %i  StampFmt: %c  StampBurst: %i)\n",
+                                  Stamp, StampFmt, StampBurst );
+         }
+         else if ( opt == 'u' )   /* -u +u +u# */
+         {
+            Flush = mx;
+            FlushMs = 0;
+
+            if ( optn[1]  &&  ( sscanf( &optn[1], "%i", &FlushMs ) != 1  ||
+                                FlushMs < 0 ) )
+            {
+               printf( "  bad flush option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+            else if ( optn[1]  &&  mx )    /* +u# = flush when idle */
+            {
+               Flush = 2;
+            }
+
+            if ( Debug )  printf( "(Flush: %i  FlushMs: %i)\n", Flush, FlushMs );
+         }
+         else if ( opt == 'j' )   /* -j# */
+         {
+            if ( sscanf( &optn[1], "%i", &Jobs ) != 1  ||  Jobs < 0 )
+            {
+               Jobs = 0;
+
+               printf( "  bad worker count option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            if ( Debug )  printf( "(Jobs: %i)\n", Jobs );
+         }
          else if ( opt == 'l' )   /* -l */
          {
             LoCase = !mx;
@@ -944,9 +6933,12 @@ int  proc_args( int* aix, int argc, char** argv )
                   AddrNum = 0;
                   Ascii = 0;
                }
-               else if ( PerLine > 24 )   /* too-long lines */
+               else if ( PerLine > PerMax )   /* too-long lines */
                {
-                  Ascii = 0;
+                  printf( "  bad bytes-per-line option \"%s\" (%i at most)\n",
+                          argv[*aix], PerMax );
+                  PerLine = 16;
+                  err = 1;
                }
             }
 
@@ -995,12 +6987,86 @@ int  proc_args( int* aix, int argc, char** argv )
                printf( "(WordLen: %i)\n", WordLen );
             }
          }
+         else if ( opt == 'y' )   /* -y -y:t## +y:t## */
+         {
+            WType = 0;
+            WBits = 0;
+            WBig = mx;    /* little-endian (-) or big-endian (+) words */
+
+            if ( optn[1] == ':'  &&  optn[2]  &&  strchr( "usxf", optn[2] ) )
+            {
+               WType = optn[2];
+
+               if ( sscanf( &optn[3], "%i", &WBits ) != 1  ||
+                    ( WBits != 8  &&  WBits != 16  &&  WBits != 32  &&
+                      WBits != 64 )  ||  ( WType == 'f'  &&  WBits < 32 ) )
+                  WBits = 0;
+            }
+
+            if ( optn[1]  &&  !WBits )
+            {
+               WType = 0;
+
+               printf( "  bad word type option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+            else if ( WBits )    /* (one word per group) */
+            {
+               HalfGap = 0;
+               WordLen = WBits / 8;
+            }
+
+            if ( Debug )
+               printf( "(WType: %c  WBits: %i  WBig: %i)\n",
+                       ( WType ? WType : '-' ), WBits, WBig );
+         }
+         else if ( opt == 'r' )   /* -r2 -r8 -r10 -r16 */
+         {
+            if ( sscanf( &optn[1], "%i", &Radix ) != 1  ||  ( Radix != 2  &&
+                 Radix != 8  &&  Radix != 10  &&  Radix != 16 ) )
+            {
+               Radix = 16;
+
+               printf( "  bad radix option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            if ( Debug )  printf( "(Radix: %i)\n", Radix );
+         }
+         else if ( opt == 's' )   /* -s -s:sect,... -s=lo-hi (ELF) */
+         {
+            ElfVad = mx;    /* address column: file offset (-) or vaddr (+) */
+
+            if ( !optn[1] )   /* -s = dump whole files again */
+            {
+               Elf = 0;
+            }
+            else if ( optn[1] == ':'  &&  optn[2] )   /* sections/segments */
+            {
+               Elf = 1;
+               ElfSel = &optn[2];
+            }
+            else if ( optn[1] == '='  &&
+                      sscanf( &optn[2], "%llx-%llx", &ElfLo, &ElfHi ) == 2 )
+            {
+               Elf = 2;    /* PT_LOAD data in a virtual address range */
+            }
+            else   /* -s? bad */
+            {
+               printf( "  bad ELF section option \"%s\"\n", argv[*aix] );
+               err = 1;
+            }
+
+            if ( Debug )  printf( "(Elf: %i  ElfVad: %i)\n", Elf, ElfVad );
+         }
          else if ( opt == 'x' )   /* -x */
          {
             HexDump = mx;
          }
          else if ( opt == 'X' )   /* -X (emulate 'hexdump -C -v') */
          {
+            Emul = 'X';
+
             TermFmt = 0;    /* don't show terminal-only (blank) lines */
             Header  = 0;    /* don't show header info in dump output */
             Footer  = 0;    /* don't show footer info in dump output */
@@ -1119,10 +7185,35 @@ int  proc_args( int* aix, int argc, char** argv )
       }
    }
 
+   plan_make();    /* lay out the dump lines for these options */
+
    return ( err );
 }
 
 
+/* arg_inputs - check whether the arguments name any input (file/process) */
+
+int  arg_inputs( int argc, char** argv )
+{
+   char  *optn;
+   int   i;
+
+   for ( i = 1;  i < argc;  i++ )
+   {
+      if ( argv[i][0] != '-'  &&  argv[i][0] != '+' )  return ( 1 );
+
+      optn = &argv[i][ ( argv[i][0] == argv[i][1] ) + 1 ];
+
+      if ( !optn[0] )  return ( i + 1 < argc );    /* '-' then a filename */
+
+      if ( !strncmp( optn, "pid", 3 )  ||  !strncmp( optn, "watch:", 6 ) )
+         return ( 1 );
+   }
+
+   return ( 0 );
+}
+
+
 int  help_msg( int mx )
 {
    if ( Debug )  printf( "(mx: %i)\n", mx );
@@ -1213,6 +7304,7 @@ int  help_msg( int mx )
       printf( "Usage:  %s  [ [ options ]  [-|--]  [ file.ext ] ] ...\n", Pgm );
       printf( "   or:  echo \"example pipe contents\"  |  %s  [ options ]\n",
               Pgm );
+      printf( "   or:  %s  [ options ]  <  file.ext\n", Pgm );
       printf( "\n" );
       printf( "Options:\n" );
       printf( "      +# = start dump at byte # (default: start at first byte"
@@ -1220,10 +7312,48 @@ int  help_msg( int mx )
       printf( "      -# = limit dump to # bytes (default: dump all bytes in"
                           " file: '-0')\n" );
       printf( "      -a = omit (-) or show (+) ASCII dump\n" );
+      printf( " -a:utf8 = show the text column as UTF-8 (characters at their"
+                          " lead bytes,\n" );
+      printf( "           blanks under the rest), -a:ascii as ASCII again\n" );
+      printf( "  -a:cp = show the text column in code page cp: latin1,"
+                          " ebcdic037, or\n" );
+      printf( "           ebcdic500 (shown as Latin-1)\n" );
+      printf( "   -a=f = show the text column through the 256-byte table in"
+                          " file f (the\n" );
+      printf( "           Latin-1 character for each byte value)\n" );
+      printf( "     -ar = dump each member of tar, tar.gz, and zip file(s)"
+                          " (+ar: off)\n" );
+      printf( " -ar:m,. = dump only the members matching m,... (wildcards"
+                          " allowed)\n" );
       printf( "     -b# = set byte group to # bytes,"
                           " -b = 1 (default), +b = 2\n" );
       printf( "      -c = continuous byte dump as fixed-length lines (-)"
                           " or single string (+)\n" );
+      printf( "-xor:hex = transform each byte: XOR with the (repeating) hex"
+                          " key, which\n" );
+      printf( "           lines up with address 0 (up to 64 key bytes)\n" );
+      printf( "  -add:# = transform each byte: add # (-sub:# to subtract),"
+                          " modulo 256\n" );
+      printf( " -bitrev = transform each byte: reverse its bits (-nibswap:"
+                          " swap nibbles)\n" );
+      printf( "     -xf = clear the byte transforms (which apply in the order"
+                          " given)\n" );
+      printf( "-stride:K:p = dump word p (default 0) of every K words (of the"
+                          " -b/-w,\n" );
+      printf( "           or -y, size), addressed by their input offsets"
+                          " (-stride: off)\n" );
+      printf( " -chan:N = dump N interleaved channels (words, as -stride) one"
+                          " after the\n" );
+      printf( "           other, each in its own section (files only; -chan:"
+                          " off)\n" );
+      printf( "  -color = color bytes by class (NUL, printable, white space,"
+                          " control,\n" );
+      printf( "           high) off (-) or on (+) (default: on for a"
+                          " terminal)\n" );
+      printf( "      -d = omit (-) or show (+) sector numbers with"
+                          " line/address numbers\n" );
+      printf( "      -D = don't (-) or do (+) use direct I/O (O_DIRECT) for"
+                          " device reads\n" );
       printf( "    -e.# = set output file extension to # (default \"%s\")\n",
               DefExts );
       printf( "      -f = output to file: file.%s (-) or file.ext.%s (+)\n",
@@ -1239,22 +7369,97 @@ int  help_msg( int mx )
                           " or input file\'s (+) directory\n" );
       printf( "           (the -f: and -f= options combine all outputs"
                           " into the named file)\n" );
+      printf( "   -done = keep (-) or delete (+) watched files once they are"
+                          " dumped\n" );
+      printf( " -done=d = move watched files to directory d once they are"
+                          " dumped\n" );
       printf( "      -i = omit (-) or show (+) information headers\n" );
+      printf( "     -j# = run # -watch workers at a time (default: one per"
+                          " CPU)\n" );
       printf( "      -l = use lowercase (-) or uppercase (+) ASCII digits"
                           " (default)\n" );
+      printf( "     -mt = read, format and write on one thread (-) or on"
+                          " three (+)\n" );
+      printf( "           (on the NUMA node that caches the input, when there"
+                          " are several)\n" );
+      printf( "    -mux = dump the following FIFOs/devices together as they"
+                          " arrive, each\n" );
+      printf( "           line tagged with its stream name (+mux: off)\n" );
       printf( "      -n = omit (-) or show (+) line/address numbers\n" );
       printf( "     -n# = format line/address as #: s:short (default), l:long,"
                           " v:variable\n" );
-      printf( "     -p# = dump # bytes per line (default 16,"
-                          " '-p' is no limit)\n" );
+      printf( "      -o = end an output: the format and -f options so far"
+                          " make one\n" );
+      printf( "           output, the next starts from them (but to stdout);"
+                          " the input\n" );
+      printf( "           is read once, and each output is rendered on its"
+                          " own thread\n" );
+      printf( "     -p# = dump # bytes per line (default 16, up to %i,"
+                          " '-p' is no limit)\n", PerMax );
+      printf( "-pid#:r,... = dump memory of process #: all regions, or"
+                          " regions r (mapping\n" );
+      printf( "           name, like \"heap\" or \"libc\", or a lo-hi hex"
+                          " address range)\n" );
+      printf( "     -r# = dump digits in radix #: 16 (hex, default), 8 (octal),"
+                          " 10\n" );
+      printf( "           (decimal), or 2 (binary bits), grouped per -b/-w\n" );
+      printf( "  -y:t## = dump ## bit (8, 16, 32, 64) little- (-) or big-endian"
+                          " (+) words\n" );
+      printf( "           of type t: u:unsigned, s:signed, x:hex, f:float (32,"
+                          " 64 only)\n" );
+      printf( "      -y = dump bytes (typed words off)\n" );
+      printf( " -s:n,... = dump ELF sections n (like .rodata) or PT_LOAD"
+                          " segments (load,\n" );
+      printf( "           load#), with file offset (-) or virtual address (+)"
+                          " addresses\n" );
+      printf( " -s=lo-hi = dump ELF PT_LOAD file data in the lo-hi (hex) vaddr"
+                          " range\n" );
+      printf( "      -s = dump whole files (ELF selection off)\n" );
+      printf( "      -t = omit (-) or show (+) arrival time stamps on each"
+                          " dump line\n" );
+      printf( "  +t:fb = time stamp format f: r:relative (default),"
+                          " a:absolute, d:delta;\n" );
+      printf( "           with b, stamp only the lines where a read (burst)"
+                          " starts\n" );
+      printf( "      -u = buffer output for throughput (-) or flush each"
+                          " dump line (+)\n" );
+      printf( "     +u# = flush output when no input has arrived for #"
+                          " milliseconds\n" );
       printf( "     -w# = set word group to # bytes, -w = 4, +w = 8\n" );
       printf( "      -x = omit (-) or show (+) hex digits dump\n" );
       printf( "      -X = emulate \'hexdump -C -v\' output format\n" );
+      printf( "      -z = dump (-) or skip (+) all-zero sectors (default: skip"
+                          " for devices)\n" );
       printf( "     -xo = hex-only dump: as bytes (-) or continuous (+)\n" );
+      printf( "    -xxd = emulate \'xxd\' output format (-xxd:p for \'xxd -p\',"
+                          " -xxd:i for\n" );
+      printf( "           \'xxd -i\')\n" );
+      printf( "     -od = emulate \'od -A x -t x1z\' output format (repeats"
+                          " shown as \'*\')\n" );
+      printf( " -base64 = encode as base64 (-) or decode base64 (+); -p#"
+                          " sets the bytes\n" );
+      printf( "           per line (default 57: 76 characters), \'-p\' is no"
+                          " line breaks\n" );
+      printf( " -base32 = encode as base32 (-) or decode base32 (+) (default"
+                          " 45 per line)\n" );
+      printf( "-ascii85 = encode as Ascii85 (-) or decode Ascii85 (+) (default"
+                          " 64 per line)\n" );
+      printf( " -cc:t=n = write C source: array n (default: from the file"
+                          " name) of type t:\n" );
+      printf( "           u8 (default), u16le, u32le, u64le (or ..be), or str"
+                          " (a string\n" );
+      printf( "           literal), and n_len (bytes); -p# sets the bytes per"
+                          " line\n" );
       printf( "  -about = show about message\n" );
       printf( "  -debug = enable debug outputs\n" );
       printf( "   -help = show help message\n" );
       printf( "    -ver = show version message\n" );
+      printf( "   -view = browse file(s) interactively (renders only the"
+                          " visible lines)\n" );
+      printf( "-watch:d = dump each file written or moved into directory d"
+                          " (until ^C),\n" );
+      printf( "           to files by the -f rules; \'kill -USR1\' reports the"
+                          " backlog\n" );
       printf( "\n" );
       printf( "The %s utility reads the specified file(s), byte-by-byte,"
               " and outputs\n", Pgm );
@@ -1273,7 +7478,18 @@ int  help_msg( int mx )
               " options affect the\n" );
       printf( "pipe dump output.  Input from a pipe overrides and precludes"
               " input from a\n" );
-      printf( "file (or files).\n" );
+      printf( "file (or files).  Other redirected input (%s < file) is dumped"
+              " when no files\n", Pgm );
+      printf( "are named; redirected files and devices are read with"
+              " seeks.\n" );
+      printf( "\n" );
+      printf( "The -view option maps the file and formats only the lines on"
+              " the screen.  Keys:\n" );
+      printf( "j/k (line), space/b (page), g/G (top/end), ':' (jump to hex"
+              " address), '/'\n" );
+      printf( "and '?' (search forward/backward for text, or hex bytes as"
+              " \"x:7f454c46\"),\n" );
+      printf( "n/N (repeat search), q (quit).\n" );
    }
 
    printf( "\n" );